@@ -5,6 +5,9 @@
  *      Author: Marco Patzer
  */
 
+#include "efm32.h"
+#include "efm32_emu.h"
+#include "efm32_cmu.h"
 #include "Algorithms.h"
 #include "payload_packet.h"
 #include "EWMA.h"
@@ -12,20 +15,52 @@
 
 STATUS_BLOCK     Algorithms::myStatusBlock;
 INTERRUPT_CONFIG Algorithms::rtcInterruptConfig;
+TIMER_Init_TypeDef Algorithms::initTimer = TIMER_INIT_DEFAULT;
+uint32_t           Algorithms::timerTicksPerSecond = 1;
 
-Configuration Algorithms::config;
+/**
+ * Preamble, sync word, length, address, type and CRC add 13 bytes to the
+ * payload.
+ */
+const uint32_t Algorithms::transmitTimeout = ( 13 + sizeof( Packet::payload ) ) * 8 * 1000 / radioBitRate + 5;
+
+#if ALGORITHM == 1
+typedef EWMA<Configuration::slotsPerDay, numeric_t, SentioPlatform> predictor_t;
+#elif ALGORITHM == 2
+typedef WCMA<Configuration::slotsPerDay, Configuration::retainDays, Configuration::retainSamples, numeric_t, SentioPlatform> predictor_t;
+#endif
 
-EWMA ewma;
-WCMA wcma;
+predictor_t predictor;
 
 time Algorithms::baseTime( 0 );
 
+EnergyLog Algorithms::energyLog;
+
+/**
+ * Readings are sent at the latest after an hour.
+ */
+UplinkBatch Algorithms::batch( UPLINK_BATCH, 3600 );
+
 volatile bool     packetReceived = false;
 volatile uint16_t packetCount    = 0;
 
+/**
+ * Progress of a transmission, advanced by the interrupt handlers.
+ */
+enum RadioState
+{
+	radioIdle,
+	radioSettling, ///< the radio is on its way to IDLE
+	radioSending,  ///< the packet is in the TX FIFO
+	radioSent,     ///< GDO0 signalled the end of the packet
+	radioTimeout   ///< TIMER1 ran out before the packet was sent
+};
+
+volatile RadioState radioState = radioIdle;
+
 Algorithms::Algorithms()
 {
-	myStatusBlock.numberOfISR         = 2;
+	myStatusBlock.numberOfISR         = 3;
 	myStatusBlock.restoreClockSetting = true;
 
 	rtcInterruptConfig.enableAlarm1           = true;
@@ -41,6 +76,9 @@ Algorithms::Algorithms()
 	ISR_Definition[1].function        = _EVEN_GPIO_InterruptHandler;
 	ISR_Definition[1].interruptNumber = GPIO_EVEN_IRQn;
 	ISR_Definition[1].anchorISR       = false;
+	ISR_Definition[2].function        = _TIMER_InterruptHandler;
+	ISR_Definition[2].interruptNumber = TIMER1_IRQn;
+	ISR_Definition[2].anchorISR       = false;
 }
 
 
@@ -74,8 +112,11 @@ bool Algorithms::_initialState()
 	cc1101.setRfConfig();
 	cc1101.setAddress( _nodeID_algorithm );
 
-	ewma.initialize();
-	wcma.initialize();
+	initializeRadioTimer();
+
+	predictor.initialize();
+
+	energyLog.initialize();
 
 #ifdef DEBUG
 	debug.printLine( "\n", true );
@@ -97,18 +138,23 @@ bool Algorithms::_mainstate()
 	debug.printLine( "In mainstate", true );
 #endif
 
-#if ALGORITHM == 1
-	ewma.do_all_the_magic();
-#elif ALGORITHM == 2
-	wcma.do_all_the_magic();
-#endif
+	energyLog.enter( EnergyLog::prediction );
+	predictor.do_all_the_magic();
+
+	const float storageVoltage = sample();
+	const float forecast       = to_float( predictor.nextPrediction() );
+	const float demand         = predictor.adaptive_slices * to_float( predictor.energyPerSamplingCycle );
 
-	sendData();
+	if ( TransmitScheduler::transmit( batch, storageVoltage, forecast, demand ) )
+		sendData();
 	/* receiveData(); */
 
+	energyLog.enter( EnergyLog::idle );
+	energyLog.commit();
+
 #ifdef DEBUG
 	debug.printLine( "going to sleep for ", false );
-	debug.printFloat( config.sleepTime, 0, false );
+	debug.printFloat( predictor.sleepTime, 0, false );
 	debug.printLine( " seconds", true );
 #endif
 
@@ -142,29 +188,58 @@ float Algorithms::getStorageVoltage()
 }
 
 
+float Algorithms::sample()
+{
+	energyLog.enter( EnergyLog::sensor );
+
+	float humidity, temperature;
+	humid.getMeasurement( humidity, temperature );
+
+	const float storageVoltage = getStorageVoltage();
+
+	batch.push( UplinkBatch::quantize( temperature, humidity,
+		predictor.adaptive_slices, predictor.sleepTime, storageVoltage ) );
+
+	return storageVoltage;
+}
+
+
 void Algorithms::sendData()
 {
 #ifdef DEBUG
 	debug.printLine( "Sending data start", true );
 #endif
 
-	float humidity, temperature;
-	humid.getMeasurement( humidity, temperature );
-
-	Packet::payload_packet.node_id         = _nodeID_algorithm;
-	Packet::payload_packet.temperature     = temperature;
-	Packet::payload_packet.humidity        = humidity;
-	Packet::payload_packet.adaptive_slices = wcma.adaptive_slices;
-	Packet::payload_packet.sleep_time      = Configuration::sleepTime;
-	Packet::payload_packet.battery_level   = getStorageVoltage();
+	energyLog.enter( EnergyLog::radio );
 
+	// The driver offers no way to read MARCSTATE, so the radio is given the
+	// time it needs to reach IDLE before the TX FIFO is written.
 	cc1101.strobe( CC1101_SIDLE );
-	for ( volatile int i = 0; i < 4000; ++i );
+	radioState = radioSettling;
+	startRadioTimer( radioSettleTime );
+	waitInEM1();
+	radioState = radioIdle;
 
-	const uint8_t packetType = 1;
-	cc1101.sendPacket( packetType, _nodeID_controller, Packet::payload, sizeof( Packet::payload ) );
+	while ( batch.count() )
+	{
+		uint8_t n = 1;
+		uint8_t size;
+
+		// a single reading is shorter without the delta encoding
+		if ( batch.count() == 1 )
+			size = WireFormat::encodeReading( _nodeID_algorithm, WireFormat::allFields, batch.oldest(), Packet::payload );
+		else
+			size = WireFormat::encodeBatch( _nodeID_algorithm, batch, Packet::payload, n );
+
+		transmit( size );
+
+		batch.drop( n );
+	}
+
+	// the log is read out once per ring, while the radio is still awake
+	if ( energyLog.full() )
+		sendEnergyLog();
 
-	for ( volatile int i = 0; i < 65535; ++i );
 	cc1101.setSleepMode();
 
 #ifdef DEBUG
@@ -174,6 +249,95 @@ void Algorithms::sendData()
 }
 
 
+void Algorithms::transmit( const uint8_t size )
+{
+	// the frame inside tells what the packet carries
+	const uint8_t packetType = 1;
+
+	radioState = radioSending;
+	startRadioTimer( transmitTimeout * 1000 );
+
+	cc1101.sendPacket( packetType, _nodeID_controller, Packet::payload, size );
+
+	waitInEM1();
+
+	TIMER_Enable( TIMER1, false );
+
+#ifdef DEBUG
+	if ( radioState == radioTimeout )
+		debug.printLine( "Transmission timed out", true );
+#endif
+
+	radioState = radioIdle;
+}
+
+
+void Algorithms::waitInEM1()
+{
+	const RadioState waiting = radioState;
+	const uint32_t   start   = TIMER_CounterGet( TIMER1 );
+
+	// With the interrupts masked, a pending interrupt still ends the EM1, but
+	// its handler only runs after unmasking. Hence the state cannot change
+	// between the check and the sleep and the wakeup is never missed.
+	__disable_irq();
+
+	while ( radioState == waiting )
+	{
+		EMU_EnterEM1();
+		__enable_irq();
+		__disable_irq();
+	}
+
+	__enable_irq();
+
+	// The cycle counter of the energy log stops in EM1. Unless the radio
+	// stopped TIMER1 at the end of the packet, it ran out at its top.
+	const uint32_t end = radioState == radioSent ? TIMER_CounterGet( TIMER1 ) : TIMER_TopGet( TIMER1 );
+
+	energyLog.charge( static_cast<uint32_t>( static_cast<uint64_t>( end - start ) * 1000000 / timerTicksPerSecond ) );
+}
+
+
+void Algorithms::initializeRadioTimer()
+{
+	CMU_ClockEnable( cmuClock_TIMER1, true );
+
+	initTimer.enable   = false;
+	initTimer.oneShot  = true;
+	initTimer.prescale = timerPrescale1024;
+
+	TIMER_Init( TIMER1, &initTimer );
+
+	timerTicksPerSecond = CMU_ClockFreqGet( cmuClock_TIMER1 ) / 1024;
+
+	TIMER_IntClear( TIMER1, TIMER_IF_OF );
+	TIMER_IntEnable( TIMER1, TIMER_IF_OF );
+}
+
+
+void Algorithms::startRadioTimer( const uint32_t microseconds )
+{
+	// rounded up, the timer must not run out early
+	const uint64_t ticks = ( static_cast<uint64_t>( timerTicksPerSecond ) * microseconds + 999999 ) / 1000000;
+
+	TIMER_TopSet( TIMER1, static_cast<uint32_t>( ticks ) );
+	TIMER_CounterSet( TIMER1, 0 );
+	TIMER_Enable( TIMER1, true );
+}
+
+
+void Algorithms::sendEnergyLog()
+{
+	for ( uint8_t i = 0, n; i < energyLog.count(); i += n )
+	{
+		transmit( WireFormat::encodeEnergyLog( _nodeID_algorithm, energyLog, i, Packet::payload, n ) );
+	}
+
+	energyLog.clear();
+}
+
+
 void Algorithms::receiveData()
 {
 
@@ -221,7 +385,15 @@ void Algorithms::receiveData()
 	debug.printDecimal( cc1101.getPacketAddress() );
 	debug.printLine( " ", true );
 
-	cc1101.getPacketPayload( Packet::payload, 0, sizeof( Packet::payload ) - 1 );
+	// the packet length includes the address and the type
+	const uint8_t length = cc1101.getPacketLength();
+	uint8_t       size   = length > 2 ? length - 2 : 0;
+
+	if ( size > sizeof( Packet::payload ) )
+		size = sizeof( Packet::payload );
+
+	if ( size )
+		cc1101.getPacketPayload( Packet::payload, 0, size - 1 );
 
 #ifdef DEBUG
 	debug.printLine( "Receiving data finished", true );
@@ -270,9 +442,27 @@ void Algorithms::_ODD_GPIO_InterruptHandler( uint32_t temp )
 
 void Algorithms::_EVEN_GPIO_InterruptHandler( uint32_t )
 {
-	packetReceived = true;
+	// GDO0 deasserts at the end of a sent packet as well as of a received one
+	if ( radioState == radioSending )
+	{
+		TIMER_Enable( TIMER1, false );
+		radioState = radioSent;
+	}
+	else
+		packetReceived = true;
 	/* sentio.LED_ToggleRed(); */
 
 	// Clear the flag
 	GPIO_IntClear( ~0 );
 }
+
+
+void Algorithms::_TIMER_InterruptHandler( uint32_t )
+{
+	TIMER_IntClear( TIMER1, TIMER_IF_OF );
+
+	if ( radioState == radioSending )
+		radioState = radioTimeout;
+	else if ( radioState == radioSettling )
+		radioState = radioIdle;
+}
@@ -10,10 +10,15 @@
 
 #include "Statemachine.h"
 #include "DriverInterface.h"
+#include "efm32_timer.h"
 
 #include "time.h"
 #include "ApplicationConfig.h"
 #include "Configuration.h"
+#include "Platform.h"
+#include "EnergyLog.h"
+#include "UplinkBatch.h"
+#include "TransmitScheduler.h"
 
 
 enum ALGORITHMS
@@ -35,8 +40,6 @@ private:
 
 	static STATUS_BLOCK myStatusBlock; ///< responsible for the state information
 
-	static Configuration config;
-
 	/**
 	 * Initialises the hardware.
 	 *
@@ -61,18 +64,92 @@ private:
 	
 	static void _EVEN_GPIO_InterruptHandler( uint32_t );
 
+	/**
+	 * Ends a transmission whose end was never signalled by the radio.
+	 */
+	static void _TIMER_InterruptHandler( uint32_t );
+
 	static time baseTime;  ///< controls the starting value of the timer
 
 	/**
-	 * Sends the data packet to a remote location via radio.
+	 * Reads the sensors and buffers the reading.
 	 *
+	 * @return Voltage of the energy storage in @f$ V @f$.
+	 */
+	static float sample();
+
+	/**
+	 * Sends the buffered readings to a remote location via radio.
+	 *
+	 * As many readings as fit go into one packet.
 	 */
 	static void sendData();
 	
 	static void receiveData();
 
+	/**
+	 * Hands the first `size` bytes of `Packet::payload` to the radio and
+	 * waits in EM1 until they are sent.
+	 *
+	 * The end of the packet is signalled by GDO0 of the radio through
+	 * `_EVEN_GPIO_InterruptHandler()`. If that never happens, TIMER1 ends the
+	 * wait after `transmitTimeout` via `_TIMER_InterruptHandler()`.
+	 */
+	static void transmit( const uint8_t size );
+
+	/**
+	 * Sleeps in EM1 until an interrupt handler changes `radioState` and
+	 * charges the time to the current phase of the energy log.
+	 */
+	static void waitInEM1();
+
+	/**
+	 * Sends the records of the energy log and clears it.
+	 */
+	static void sendEnergyLog();
+
+	static EnergyLog energyLog;  ///< time and energy of the phases
+
+	static UplinkBatch batch;  ///< readings not sent yet
+
 	static INTERRUPT_CONFIG rtcInterruptConfig;
 
+	/**
+	 * Bit rate of the radio, has to match `setRfConfig()` of the driver.
+	 *
+	 * Value in @f$ bit/s @f$
+	 */
+	static const uint32_t radioBitRate = 38400;
+
+	/**
+	 * Longest time a packet is on the air plus a few milliseconds of margin.
+	 *
+	 * Value in @f$ ms @f$
+	 */
+	static const uint32_t transmitTimeout;
+
+	/**
+	 * Time the radio needs to reach IDLE after the SIDLE strobe, including
+	 * the start of the crystal if it was asleep.
+	 *
+	 * Value in @f$ \mu s @f$
+	 */
+	static const uint32_t radioSettleTime = 1000;
+
+	static TIMER_Init_TypeDef initTimer;
+
+	static uint32_t timerTicksPerSecond;  ///< counting rate of TIMER1
+
+	/**
+	 * Sets up TIMER1 as a one-shot timer for the waits of the radio.
+	 */
+	static void initializeRadioTimer();
+
+	/**
+	 * Starts TIMER1, it runs out after at least `microseconds`.
+	 */
+	static void startRadioTimer( const uint32_t microseconds );
+
 public:
 	Algorithms();
 	~Algorithms() {}
@@ -99,7 +176,44 @@ public:
 	ERROR_CODE executeApplication();
 	uint8_t    setupApplication();
 	
-	friend class EWMA;
+	friend class SentioPlatform;
+};
+
+
+/**
+ * Platform of the algorithms on the sensor node.
+ *
+ * Forwards to the drivers used by `Algorithms`, see `Platform.h`.
+ */
+class SentioPlatform
+{
+public:
+
+	float getLuminance()
+	{
+		return Algorithms::getLuminance();
+	}
+
+	float getStorageVoltage()
+	{
+		return Algorithms::getStorageVoltage();
+	}
+
+	void resetClock()
+	{
+		const EnergyLog::Phase phase = Algorithms::energyLog.enter( EnergyLog::sleepEntry );
+		Algorithms::timer.setBaseTime( Algorithms::baseTime );
+		Algorithms::energyLog.enter( phase );
+	}
+
+	void sleep( const unsigned int seconds )
+	{
+		const EnergyLog::Phase phase = Algorithms::energyLog.enter( EnergyLog::sleepEntry );
+		Algorithms::timer.setAlarmPeriod( seconds, alarm1, alarmMatchHour_Minutes_Seconds );
+		Algorithms::timer.resetInterrupts();
+		Algorithms::timer.setLowPowerMode();
+		Algorithms::energyLog.enter( phase );
+	}
 };
 
 #endif /* ALGORITHMS_H_ */
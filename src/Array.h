@@ -9,7 +9,10 @@
 #define ARRAY_H_DAHB3GQW
 
 #include <cstddef>    ///< for `size_t`
+#include <cstdlib>    ///< for `abs`
 #include <algorithm>  ///< for `fill`
+#include <limits>     ///< for `numeric_limits`
+#include "Numeric.h"  ///< for `NumericPolicy`
 
 /**
  * A container for storing a fixed size sequence of elements.
@@ -21,11 +24,31 @@
  * @param The number of elements in the list. Needs to be provided when an
  * object of this class is instantiated and is fixed during the life time of
  * the object.
+ *
+ * @param Running-sum mode. If set, the sum of all elements is kept up to
+ * date in `push()` and `fill()`, so `sum()` and `average()` cost
+ * @f$ O(1) @f$ instead of @f$ O(N) @f$. In this mode the elements must only
+ * be altered through `push()` and `fill()`; writes through `operator[]` or
+ * the iterators are not tracked until `resync()` is called.
  */
-template <typename T, const std::size_t N> class Array
+template <typename T, const std::size_t N, const bool RunningSum = false> class Array
 {
 	T  buffer[N]; ///< main storage array
 	T* ptr;       ///< pointer used in the `push()` and `pop()` methods
+	T  total;     ///< sum of all elements, only maintained in running-sum mode
+
+	std::size_t count;  ///< number of elements stored through `push()` or `fill()`
+
+	/**
+	 * Sums up all elements by scanning the whole buffer.
+	 */
+	const T accumulate() const
+	{
+		T t = 0;
+		for ( std::size_t i = 0; i < N; ++i )
+			t += *( buffer + i );
+		return t;
+	}
 
 public:
 
@@ -36,6 +59,54 @@ public:
 	typedef       T* iterator;
 	typedef const T* const_iterator;
 
+	/**
+	 * Iterator walking the stored values from the oldest to the newest.
+	 *
+	 * Unlike `const_iterator`, which follows the storage order, it starts at
+	 * the oldest value with respect to the write pointer of `push()` and
+	 * wraps around at the end of the buffer.
+	 */
+	class chrono_iterator
+	{
+		const T*    base;   ///< beginning of the buffer
+		std::size_t start;  ///< index of the oldest value
+		std::size_t pos;    ///< number of values already passed
+
+	public:
+
+		chrono_iterator( const T* b, const std::size_t s, const std::size_t p ) :
+			base( b ), start( s ), pos( p ) {}
+
+		const_reference operator*() const
+		{
+			const std::size_t i = start + pos;
+			return base[i < N ? i : i - N];
+		}
+
+		chrono_iterator& operator++()
+		{
+			++pos;
+			return *this;
+		}
+
+		chrono_iterator operator++( int )
+		{
+			chrono_iterator it( *this );
+			++pos;
+			return it;
+		}
+
+		bool operator==( const chrono_iterator& other ) const
+		{
+			return pos == other.pos;
+		}
+
+		bool operator!=( const chrono_iterator& other ) const
+		{
+			return pos != other.pos;
+		}
+	};
+
 	iterator begin()
 	{
 		return iterator( data() );
@@ -56,6 +127,26 @@ public:
 		return const_iterator( data() + N );
 	}
 
+	/**
+	 * Beginning of the stored values in chronological order.
+	 *
+	 * @return Iterator to the oldest stored value.
+	 */
+	chrono_iterator chrono_begin() const
+	{
+		return chrono_iterator( buffer, count < N ? 0 : ptr - buffer, 0 );
+	}
+
+	/**
+	 * End of the stored values in chronological order.
+	 *
+	 * @return Iterator past the newest stored value.
+	 */
+	chrono_iterator chrono_end() const
+	{
+		return chrono_iterator( buffer, count < N ? 0 : ptr - buffer, count );
+	}
+
 	pointer data()
 	{
 		return buffer;
@@ -108,21 +199,70 @@ public:
 	 *
 	 * Initialises all elements with zero.
 	 */
-	Array() : ptr( buffer )
+	Array() : ptr( buffer ), total( 0 ), count( 0 )
 	{
 		std::fill( buffer, buffer + N, T( 0 ) );
 	}
 
+	/**
+	 * Copy constructor
+	 *
+	 * The write pointer is rebased onto the own buffer, otherwise it would
+	 * still point into the buffer of the copied object.
+	 */
+	Array( const Array& other ) :
+		ptr( buffer + ( other.ptr - other.buffer ) ), total( other.total ), count( other.count )
+	{
+		std::copy( other.buffer, other.buffer + N, buffer );
+	}
+
+	Array& operator=( const Array& other )
+	{
+		std::copy( other.buffer, other.buffer + N, buffer );
+		ptr   = buffer + ( other.ptr - other.buffer );
+		total = other.total;
+		count = other.count;
+		return *this;
+	}
+
 	/**
 	 * Initialises with a default value.
 	 *
 	 * All elements of the array are initialised with the value provided.
+	 * Afterwards the array counts as completely filled.
 	 *
 	 * @param t The value used for initialisation.
 	 */
 	void fill( const T& t )
 	{
 		std::fill( buffer, buffer + N, T( t ) );
+		count = N;
+		resync();
+	}
+
+	/**
+	 * Resets the array to the state after construction.
+	 *
+	 * All elements are set to zero and no element counts as stored.
+	 */
+	void clear()
+	{
+		std::fill( buffer, buffer + N, T( 0 ) );
+		ptr   = buffer;
+		total = 0;
+		count = 0;
+	}
+
+	/**
+	 * Recomputes the running sum from the stored elements.
+	 *
+	 * Only has an effect in running-sum mode. Needs to be called after the
+	 * elements have been altered through `operator[]` or the iterators.
+	 */
+	void resync()
+	{
+		if ( RunningSum )
+			total = accumulate();
 	}
 
 	/**
@@ -139,24 +279,56 @@ public:
 		return N;
 	}
 
+	/**
+	 * The number of elements which have already been stored.
+	 *
+	 * Counts the values stored with `push()` up to the capacity. Since the
+	 * write pointer starts at the beginning of the buffer, the stored values
+	 * occupy the indices @f$ 0 @f$ up to `filled()` until the array is full.
+	 *
+	 * @return Number of valid elements.
+	 */
+	std::size_t filled() const
+	{
+		return count;
+	}
+
 	/**
 	 * Stores a value in the array.
 	 *
 	 * If stored value overwrites the oldest value.
+	 *
+	 * In running-sum mode the overwritten value is subtracted from the sum
+	 * and the new one is added. For inexact types like `float` the rounding
+	 * errors of these updates would accumulate, hence the sum is recomputed
+	 * from scratch once per revolution of the write pointer.
 	 */
 	void push( const T& t )
 	{
+		if ( RunningSum )
+			total += t - *ptr;
+
 		*ptr = t;
+
+		if ( count < N )
+			++count;
+
 		if ( ++ptr >= ( buffer + N ) )
+		{
 			ptr = buffer;
+
+			if ( !std::numeric_limits<T>::is_exact )
+				resync();
+		}
 	}
 
 	/**
 	 * Retrieves the last value in the array.
 	 *
 	 * If this method is called consecutively, it always retrieves the last
-	 * value, regardless how often it is called. This means if less values are
-	 * stored than the maximum capacity, a zero is returned.
+	 * value, regardless how often it is called. If nothing has been stored
+	 * yet, the initial content of the position is returned: zero after
+	 * construction or `clear()`, the value given to `fill()` after `fill()`.
 	 *
 	 * @return The last value from the array.
 	 */
@@ -168,6 +340,79 @@ public:
 			return *( ptr - 1 );
 	}
 
+	/**
+	 * The index of a value relative to the write pointer.
+	 *
+	 * @param n How many values have been stored after the requested one,
+	 * needs to be smaller than @f$ N @f$.
+	 *
+	 * @return Index in the buffer of the value stored @f$ n @f$ calls of
+	 * `push()` ago.
+	 */
+	std::size_t index_last( const std::size_t n ) const
+	{
+		const std::size_t p = ptr - buffer;
+		return p > n ? p - n - 1 : p + N - n - 1;
+	}
+
+	/**
+	 * Retrieves a value relative to the write pointer.
+	 *
+	 * `last( 0 )` is the same as `pop()`, `last( 1 )` the value stored
+	 * before and so on. If less than @f$ n+1 @f$ values have been stored,
+	 * the initial content of the position is returned, see `pop()`.
+	 *
+	 * @param n How many values have been stored after the requested one,
+	 * needs to be smaller than @f$ N @f$.
+	 *
+	 * @return The value stored @f$ n @f$ calls of `push()` ago.
+	 */
+	const T last( const std::size_t n ) const
+	{
+		return buffer[index_last( n )];
+	}
+
+	/**
+	 * Computes the sum of the @f$ n @f$ most recently stored values.
+	 *
+	 * The window ends at the write pointer and may wrap around the end of
+	 * the buffer. It is summed up in at most two contiguous passes. The
+	 * window is limited to the values which have already been stored.
+	 *
+	 * @param @f$ n @f$
+	 * @return The sum of the last @f$ n @f$ stored values.
+	 */
+	const T sum_last( const std::size_t n ) const
+	{
+		const std::size_t m = std::min( n, count );
+		const std::size_t p = ptr - buffer;
+		T t = 0;
+
+		if ( m > p )
+			for ( std::size_t i = N + p - m; i < N; ++i )
+				t += *( buffer + i );
+
+		for ( std::size_t i = m > p ? 0 : p - m; i < p; ++i )
+			t += *( buffer + i );
+
+		return t;
+	}
+
+	/**
+	 * Computes the average over the @f$ n @f$ most recently stored values.
+	 *
+	 * @see sum_last()
+	 *
+	 * @param @f$ n @f$
+	 * @return The average over the last @f$ n @f$ stored values, zero if none
+	 * is stored.
+	 */
+	const T average_last( const std::size_t n ) const
+	{
+		const std::size_t m = std::min( n, count );
+		return m ? sum_last( n ) / m : 0;
+	}
+
 	/**
 	 * Computes the sum of all values in the array.
 	 *
@@ -175,14 +420,14 @@ public:
 	 * wrong since the sum includes the zeros that are used to initialise the
 	 * array.
 	 *
+	 * In running-sum mode the maintained sum is returned without scanning
+	 * the buffer.
+	 *
 	 * @return The sum of all values in the array.
 	 */
 	const T sum() const
 	{
-		T t = 0;
-		for ( std::size_t i = 0; i < N; ++i )
-			t += *( buffer + i );
-		return t;
+		return RunningSum ? total : accumulate();
 	}
 
 	/**
@@ -239,6 +484,77 @@ public:
 		return n == 0 ? 0 : sum( n ) / abs( n );
 	}
 
+	/**
+	 * Computes the sum of the values which have already been stored.
+	 *
+	 * In contrast to `sum()` the zero padding is excluded, which makes no
+	 * difference for the sum itself, but is the counterpart to
+	 * `average_valid()`.
+	 *
+	 * In running-sum mode the maintained sum is returned, the padding adds
+	 * nothing to it.
+	 *
+	 * @return The sum of all stored values.
+	 */
+	const T sum_valid() const
+	{
+		return RunningSum || count == N ? sum() : sum( static_cast<int>( count ) );
+	}
+
+	/**
+	 * Computes the sum of the first or last @f$ n @f$ stored values.
+	 *
+	 * Same as `sum( n )`, but restricted to the stored values. If
+	 * @f$ n @f$ is negative, the last @f$ n @f$ of the stored values, from
+	 * `filled()`@f$ +n @f$ up to `filled()`, are summed up.
+	 *
+	 * @param @f$ n @f$
+	 * @return The sum of the first or last @f$ n @f$ stored values.
+	 */
+	const T sum_valid( const int n ) const
+	{
+		const int valid = static_cast<int>( count );
+		T t = 0;
+
+		if ( n >= 0 )
+			for ( int i = 0; i < n && i < valid; ++i )
+				t += *( buffer + i );
+		else
+			for ( int i = valid + n > 0 ? valid + n : 0; i < valid; ++i )
+				t += *( buffer + i );
+
+		return t;
+	}
+
+	/**
+	 * Computes the average over the values which have already been stored.
+	 *
+	 * Unlike `average()` the result is correct before the array has been
+	 * filled completely, since only the stored values are taken into
+	 * account.
+	 *
+	 * @return The average over all stored values, zero if none is stored.
+	 */
+	const T average_valid() const
+	{
+		return count ? sum_valid() / count : 0;
+	}
+
+	/**
+	 * Computes the average over the first or last @f$ n @f$ stored values.
+	 *
+	 * @see sum_valid( const int n )
+	 *
+	 * @param @f$ n @f$
+	 * @return The average over the first or last @f$ n @f$ stored values,
+	 * zero if none is stored.
+	 */
+	const T average_valid( const int n ) const
+	{
+		const std::size_t m = std::min<std::size_t>( abs( n ), count );
+		return m ? sum_valid( n ) / m : 0;
+	}
+
 	/**
 	 * Computes the dot product.
 	 *
@@ -246,14 +562,18 @@ public:
 	 * @f$ n @f$, are averaged. If @f$ n @f$ is negative, then the last
 	 * values, from @f$ N+n @f$ up to @f$ N @f$ are averaged.
 	 *
+	 * The products are accumulated with `NumericPolicy<T>::mac()`, which
+	 * saturates for fixed-point types.
+	 *
 	 * @param The array to multiply with.
 	 * @return The dot product of both arrays of type @f$ T @f$.
 	 */
-	const T dotproduct( const Array<T, N> &second ) const
+	template <bool R>
+	const T dotproduct( const Array<T, N, R> &second ) const
 	{
 		T t = 0;
 		for ( std::size_t i = 0; i < N; ++i )
-			t += *( buffer + i ) * second[i];
+			t = NumericPolicy<T>::mac( t, *( buffer + i ), second[i] );
 		return t;
 	}
 
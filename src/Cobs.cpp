@@ -0,0 +1,63 @@
+/*
+ * Cobs.cpp
+ *
+ *  Created on: 2026-10-17
+ *      Author: agent
+ */
+
+#include "Cobs.h"
+
+size_t Cobs::encode( const uint8_t *in, const size_t size, uint8_t *out )
+{
+	size_t  code_index = 0;
+	size_t  n          = 1;
+	uint8_t code       = 1;
+
+	for ( size_t i = 0; i < size; ++i )
+	{
+		if ( in[i] )
+		{
+			out[n++] = in[i];
+			++code;
+		}
+
+		if ( !in[i] || code == 0xff )
+		{
+			out[code_index] = code;
+			code_index      = n++;
+			code            = 1;
+		}
+	}
+
+	out[code_index] = code;
+
+	return n;
+}
+
+size_t Cobs::decode( const uint8_t *in, const size_t size, uint8_t *out )
+{
+	size_t n = 0;
+
+	for ( size_t i = 0; i < size; )
+	{
+		const uint8_t code = in[i++];
+
+		if ( !code || i + code - 1 > size )
+			return 0;
+
+		for ( uint8_t k = 1; k < code; ++k )
+		{
+			// the encoder never writes a zero
+			if ( !in[i] )
+				return 0;
+
+			out[n++] = in[i++];
+		}
+
+		// the zero after the last run is implied
+		if ( code < 0xff && i < size )
+			out[n++] = 0;
+	}
+
+	return n;
+}
@@ -0,0 +1,51 @@
+/*
+ * Cobs.h
+ *
+ *  Created on: 2026-10-17
+ *      Author: agent
+ */
+
+#ifndef COBS_H_N8RA4VKE
+#define COBS_H_N8RA4VKE
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Consistent overhead byte stuffing.
+ *
+ * Removes all zeros from a block of bytes, so a zero can delimit the blocks
+ * in a stream. Each run of up to 254 bytes without a zero is preceded by a
+ * code byte, which is the length of the run plus one. A code below 255
+ * stands for the run followed by a zero, the last zero is implied. The
+ * overhead is one byte per 254 bytes at most.
+ *
+ * Used between the controller and the host, the delimiter is not part of
+ * the encoded block.
+ */
+namespace Cobs
+{
+	/**
+	 * @return Size of a block of @f$ n @f$ bytes after encoding at most.
+	 */
+	inline size_t maxEncodedSize( const size_t n )
+	{
+		return n + n / 254 + 1;
+	}
+
+	/**
+	 * @param out Destination, `maxEncodedSize( size )` bytes.
+	 *
+	 * @return Bytes written.
+	 */
+	size_t encode( const uint8_t *in, const size_t size, uint8_t *out );
+
+	/**
+	 * @param out Destination, `size` bytes.
+	 *
+	 * @return Bytes written, zero if the block is not valid.
+	 */
+	size_t decode( const uint8_t *in, const size_t size, uint8_t *out );
+}
+
+#endif /* end of include guard: COBS_H_N8RA4VKE */
@@ -7,14 +7,18 @@
 
 #include "Configuration.h"
 
-unsigned int Configuration::sleepTime              = 10;
-unsigned int Configuration::minDutyCycle           = 1800;
-unsigned int Configuration::maxDutyCycle           = 300;
-float        Configuration::weightingFactor        = .5;
-float        Configuration::energyPerSamplingCycle = .0002;
-float        Configuration::energyPerStorageCycle  = .04;
-const float  Configuration::energyStorageEmpty     = 1.0;
-const float  Configuration::energyStorageFull      = 2.5;
+const numeric_t Configuration::energyStorageEmpty = numeric_t( 1.0 );
+const numeric_t Configuration::energyStorageFull  = numeric_t( 2.5 );
+
+Configuration::Configuration() :
+	minDutyCycle          ( 1800 ),
+	maxDutyCycle          ( 300 ),
+	sleepTime             ( 10 ),
+	weightingFactor       ( .5 ),
+	energyPerSamplingCycle( .0002 ),
+	energyPerStorageCycle ( .04 )
+{
+}
 
 void Configuration::updateConfiguration( uint8_t *configPacket )
 {
@@ -9,20 +9,39 @@
 #define CONFIGURATION_H_THZVIP5A
 
 #include <stdint.h>
+#include "Numeric.h"
+
+/**
+ * Number type used by the algorithms.
+ *
+ * Selected with the `FIXED_POINT` flag in the `Makefile`. A value of zero
+ * selects `float`, otherwise it is the number of fractional bits of a
+ * fixed-point type, e.g. 16 for Q16.16 or 24 for Q8.24.
+ */
+#if FIXED_POINT
+typedef Fixed<FIXED_POINT> numeric_t;
+#else
+typedef float numeric_t;
+#endif
 
 /**
  * Stores general configuration.
  *
  * This class stores static and dynamic configuration and provides a means to
  * update the settings used by the algorithms.
+ *
+ * The static values are the defaults for the template parameters of the
+ * algorithms. The dynamic values are members, every algorithm object
+ * carries its own copy, so several of them can run side by side with
+ * different settings.
  */
 struct Configuration
 {
 	static const unsigned int secondsPerDay = 86400;  ///< value in @f$ s @f$
 
-	static unsigned int minDutyCycle;  ///< value in @f$ s @f$
-	static unsigned int maxDutyCycle;  ///< value in @f$ s @f$
-	static unsigned int sleepTime;
+	unsigned int minDutyCycle;  ///< value in @f$ s @f$
+	unsigned int maxDutyCycle;  ///< value in @f$ s @f$
+	unsigned int sleepTime;     ///< value in @f$ s @f$
 
 	/**
 	 * Number of columns in the energy prediction matrix. This many samples
@@ -30,7 +49,7 @@ struct Configuration
 	 */
 	static const unsigned int slotsPerDay = 48;
 
-	static float weightingFactor;  ///< @f$ =\alpha @f$
+	numeric_t weightingFactor;  ///< @f$ =\alpha @f$
 
 	/**
 	 * Number of rows in the energy prediction matrix. Samples for this many
@@ -45,22 +64,22 @@ struct Configuration
 	 */
 	static const unsigned int retainSamples = 3;
 
-	static float energyPerSamplingCycle;  ///< value in @f$ J @f$
-	static float energyPerStorageCycle;   ///< value in @f$ J @f$
+	numeric_t energyPerSamplingCycle;  ///< value in @f$ J @f$
+	numeric_t energyPerStorageCycle;   ///< value in @f$ J @f$
 
 	/**
 	 * An energy storage level lower than this treats the storage as empty.
 	 *
 	 * Value in @f$ V @f$
 	 */
-	static const float energyStorageEmpty;
+	static const numeric_t energyStorageEmpty;
 	
 	/**
 	 * An energy storage level higher than this treats the storage as full.
 	 *
 	 * Value in @f$ V @f$
 	 */
-	static const float energyStorageFull;
+	static const numeric_t energyStorageFull;
 
 	/**
 	 * Processes a configuration packet.
@@ -71,7 +90,12 @@ struct Configuration
 	 */
 	void updateConfiguration( uint8_t *configPacket );
 
-	Configuration() {}
+	/**
+	 * Constructor
+	 *
+	 * Initialises the dynamic values with their defaults.
+	 */
+	Configuration();
 };
 
 #endif /* end of include guard: CONFIGURATION_H_THZVIP5A */
@@ -7,6 +7,8 @@
 
 #include "Controller.h"
 #include "payload_packet.h"
+#include "Cobs.h"
+#include "efm32_usart.h"
 
 STATUS_BLOCK     Controller::myStatusBlock;
 INTERRUPT_CONFIG Controller::rtcInterruptConfig;
@@ -144,8 +146,13 @@ bool Controller::_radio_send()
 	debug.printLine( " ", true );
 #endif
 
-	/* cc1101.sendPacket( serial.type, serial.address, serial.payload, serial.payload_size ); */
-	cc1101.sendPacket( 1, 3, Packet::payload, 11 );
+	// a cut payload would be sent as a different frame
+	if ( serial.payload_size <= sizeof( serial.payload ) )
+		cc1101.sendPacket( serial.type, serial.address, serial.payload, serial.payload_size );
+#ifdef DEBUG
+	else
+		debug.printLine( "Payload too long, not sent", true );
+#endif
 
 	myStatusBlock.nextState   = mainstate;
 	myStatusBlock.wantToSleep = true;
@@ -209,27 +216,19 @@ bool Controller::_radio_receive()
 
 		// payload
 		/* debug.printLine( "Payload: ", false ); */
-		cc1101.getPacketPayload( Packet::payload, 0, sizeof( Packet::payload ) - 1 );
-
-		/* debug.printLine( "Sender node ID: ", false ); */
-		debug.printLine( ", ", false );
-		debug.printFloat( Packet::payload_packet.node_id, 2, false );
-		debug.printLine( ", ", false );
-		/* debug.printLine( "Temperature: ", false ); */
-		debug.printFloat( Packet::payload_packet.temperature, 5, false );
-		debug.printLine( ", ", false );
-		/* debug.printLine( "Humidity: ", false ); */
-		debug.printFloat( Packet::payload_packet.humidity, 5, false );
-		debug.printLine( ", ", false );
-		/* debug.printLine( "adaptive_slices: ", false ); */
-		debug.printFloat( Packet::payload_packet.adaptive_slices, 5, false );
-		debug.printLine( ", ", false );
-		/* debug.printLine( "sleep_time: ", false ); */
-		debug.printFloat( Packet::payload_packet.sleep_time, 5, false );
-		debug.printLine( ", ", false );
-		/* debug.printLine( "battery_level: ", false ); */
-		debug.printFloat( Packet::payload_packet.battery_level, 5, false );
-		debug.printLine( "\n", false );
+		// the packet length includes the address and the type
+		const uint8_t length = cc1101.getPacketLength();
+		uint8_t       size   = length > 2 ? length - 2 : 0;
+		if ( size > sizeof( Packet::payload ) )
+			size = sizeof( Packet::payload );
+		if ( size )
+			cc1101.getPacketPayload( Packet::payload, 0, size - 1 );
+
+#if BINARY_OUTPUT
+		forwardPacket( size );
+#else
+		printPacket( size );
+#endif
 
 		cc1101.setReceiveMode();
 	}
@@ -241,6 +240,82 @@ bool Controller::_radio_receive()
 }
 
 
+void Controller::forwardPacket( const uint8_t size )
+{
+	uint8_t record[2 + WireFormat::maxFrameSize];
+	uint8_t block[2 + WireFormat::maxFrameSize + 1];  // one code byte per 254 bytes
+
+	const float rssi = cc1101.getRssiValue();
+
+	record[0] = static_cast<uint8_t>( static_cast<int8_t>( rssi < 0 ? rssi - .5f : rssi + .5f ) );
+	record[1] = cc1101.getLqiValue();
+
+	for ( uint8_t i = 0; i < size; ++i )
+		record[2 + i] = Packet::payload[i];
+
+	const size_t n = Cobs::encode( record, 2 + size, block );
+
+	USART_Tx( UART0, 0 );
+
+	for ( size_t i = 0; i < n; ++i )
+		USART_Tx( UART0, block[i] );
+
+	USART_Tx( UART0, 0 );
+}
+
+
+void Controller::printPacket( const uint8_t size )
+{
+	WireFormat::Header   header;
+	UplinkBatch::Reading readings[UplinkBatch::capacity];
+	uint8_t              n = 0;
+
+	if ( WireFormat::decodeHeader( Packet::payload, size, header ) )
+		switch ( header.type )
+		{
+		case WireFormat::reading:
+			n = WireFormat::decodeReading( Packet::payload, size, readings[0] );
+			break;
+
+		case WireFormat::batch:
+			n = WireFormat::decodeBatch( Packet::payload, size, readings );
+			break;
+
+		default:
+			break;
+		}
+
+	for ( uint8_t i = 0; i < n; ++i )
+		printReading( header.node_id, readings[i].temperature / 10.f,
+			readings[i].humidity / 10.f, readings[i].adaptive_slices,
+			readings[i].sleep_time, readings[i].battery_level / 1000.f );
+}
+
+
+void Controller::printReading( const uint8_t nodeID, const float temperature, const float humidity,
+	const float adaptiveSlices, const float sleepTime, const float batteryLevel )
+{
+	/* debug.printLine( "Sender node ID: ", false ); */
+	debug.printLine( ", ", false );
+	debug.printFloat( nodeID, 2, false );
+	debug.printLine( ", ", false );
+	/* debug.printLine( "Temperature: ", false ); */
+	debug.printFloat( temperature, 5, false );
+	debug.printLine( ", ", false );
+	/* debug.printLine( "Humidity: ", false ); */
+	debug.printFloat( humidity, 5, false );
+	debug.printLine( ", ", false );
+	/* debug.printLine( "adaptive_slices: ", false ); */
+	debug.printFloat( adaptiveSlices, 5, false );
+	debug.printLine( ", ", false );
+	/* debug.printLine( "sleep_time: ", false ); */
+	debug.printFloat( sleepTime, 5, false );
+	debug.printLine( ", ", false );
+	/* debug.printLine( "battery_level: ", false ); */
+	debug.printFloat( batteryLevel, 5, false );
+	debug.printLine( "\n", false );
+}
+
 ERROR_CODE Controller::executeApplication()
 {
 	return startApplication( &myStatusBlock );
@@ -14,6 +14,7 @@
 #include "ApplicationConfig.h"
 #include "SystemConfig.h"
 #include "efm32_timer.h"
+#include "WireFormat.h"
 
 
 enum CONTROLLER
@@ -33,7 +34,7 @@ public:
 	uint8_t address;
 	uint8_t type;
 	uint8_t payload_size;
-	uint8_t payload[64];
+	uint8_t payload[WireFormat::maxFrameSize];  ///< longer payloads are cut
 
 	Serial() : byte_number( 0 ) {};
 
@@ -56,7 +57,10 @@ public:
 			break;
 
 		default:
-			payload[byte_number - 3] = c_data;
+			// the rest of a longer payload is read but not stored, so the
+			// next frame starts at the right byte
+			if ( byte_number - 3 < sizeof( payload ) )
+				payload[byte_number - 3] = c_data;
 		}
 
 		++byte_number;
@@ -115,6 +119,31 @@ private:
 	static void _EVEN_GPIO_InterruptHandler( uint32_t temp );
 	static void _SERIAL_InterruptHandler( uint32_t temp );
 
+	/**
+	 * Forwards the received frame in binary to the host.
+	 *
+	 * The frame is preceded by the RSSI in @f$ dBm @f$ as a signed byte and
+	 * the LQI byte of the radio. The record is encoded with `Cobs` and
+	 * enclosed in zero bytes. The leading one ends any debug text printed
+	 * on the UART before, which is then skipped as an invalid record.
+	 *
+	 * @param size Bytes of the frame in `Packet::payload`.
+	 */
+	static void forwardPacket( const uint8_t size );
+
+	/**
+	 * Prints the readings of the received frame as text.
+	 *
+	 * @param size Bytes of the frame in `Packet::payload`.
+	 */
+	static void printPacket( const uint8_t size );
+
+	/**
+	 * Prints one reading as a line of comma separated values.
+	 */
+	static void printReading( const uint8_t nodeID, const float temperature, const float humidity,
+		const float adaptiveSlices, const float sleepTime, const float batteryLevel );
+
 	static time baseTime;  ///< controls the starting value of the timer
 	static time delayTime; ///< controls the sleep duration
 
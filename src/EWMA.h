@@ -9,13 +9,37 @@
 #define EWMA_H_PB1IR8OZ
 
 #include <cmath>
-#include "Algorithms.h"
+#include "Platform.h"
 #include "Configuration.h"
 #include "HistoricalAverage.h"
 
+#ifdef DEBUG
+#include "DriverInterface.h"
+#endif
 
+
+/**
+ * Exponentially-weighted moving average.
+ *
+ * @param Number of slots per day.
+ * @param The number type used for the computation, e.g. `float` or
+ * `q16_16_t`.
+ * @param The access to sensors and clock, see `Platform.h`.
+ */
+template <const std::size_t N = Configuration::slotsPerDay, typename T = numeric_t,
+		  typename Platform = SentioPlatform>
 class EWMA : public Configuration
 {
+	unsigned int current_slice;
+
+	T energy_current_slot;
+
+	HistoricalAverage <N, T> historicalAverage;
+
+	Platform platform;
+
+public:
+
 	/**
 	 * Variable for setting the duty-cycle.
 	 *
@@ -23,23 +47,15 @@ class EWMA : public Configuration
 	 * duty-cycle. It can not be smaller than one. One represents one slice
 	 * per slot.
 	 */
-	static int adaptive_slices;
+	int adaptive_slices;
 
-	unsigned int current_slice;
+	explicit EWMA( const Platform& p = Platform() ) : platform( p ), adaptive_slices( 1 ) {}
 
-	float energy_current_slot;
-
-	HistoricalAverage <48, float> historicalAverage;
-
-public:
-
-	EWMA() {}
-	
 	/**
-	 * Fills the historical average array.
+	 * Empties the historical average array.
 	 *
-	 * The luminance is measured once and the circular buffer
-	 * `historicalAverage` is filled with the measured value.
+	 * Only the slots measured after this call are taken into account for the
+	 * historical average.
 	 */
 	void initialize();
 
@@ -52,7 +68,20 @@ public:
 	 * the energy surplus or shortfall of the last slot.
 	 */
 	void calculateAdaptiveSlices();
-	
+
+	/**
+	 * Calculates the prediction for the next slot.
+	 *
+	 * This is the expected average per slot, which the number of slices is
+	 * based on.
+	 *
+	 * @return Predicted value for the next slot
+	 */
+	T nextPrediction() const
+	{
+		return historicalAverage.filled() ? historicalAverage.average_valid() : energy_current_slot;
+	}
+
 	/**
 	 * Set the sleep time
 	 */
@@ -66,6 +95,106 @@ public:
 	 * @return Energy measured in the current slice.
 	 */
 	float do_all_the_magic();
+
+	/**
+	 * The slice of the current slot.
+	 *
+	 * Zero right after `do_all_the_magic()` started a new slot.
+	 */
+	unsigned int currentSlice() const
+	{
+		return current_slice;
+	}
 };
 
+
+template <const std::size_t N, typename T, typename Platform>
+void EWMA<N, T, Platform>::calculateAdaptiveSlices()
+{
+
+#ifdef DEBUG
+	DriverInterface::debug.printLine( "Entered: calculateAdaptiveSlices", true );
+#endif
+
+	const T alpha        = numeric_cast<T>( weightingFactor );
+	const T storageCycle = numeric_cast<T>( energyPerStorageCycle );
+
+	energy_current_slot = from_float<T>( platform.getLuminance() );
+
+	const bool warm                   = historicalAverage.filled();
+	const T    oldHistAvg             = warm ? historicalAverage.pop() : energy_current_slot;
+	const T    newHistAvg             = alpha * oldHistAvg + ( 1 - alpha ) * energy_current_slot;
+	const T    expectedAveragePerSlot = warm ? historicalAverage.average_valid() : newHistAvg;
+
+	adaptive_slices = NumericPolicy<T>::ceil( ( expectedAveragePerSlot - storageCycle ) / storageCycle + 1 );
+
+	if ( adaptive_slices < 1 )
+		adaptive_slices = 1;
+
+	sleepTime = minDutyCycle / adaptive_slices;
+
+	historicalAverage.push( newHistAvg );
+
+#ifdef DEBUG
+	DriverInterface::debug.printLine( "\tOld historical average value, oldHistAvg: ", false );
+	DriverInterface::debug.printFloat( to_float( oldHistAvg ), 7, true );
+
+	DriverInterface::debug.printLine( "\tNew historical average value, newHistAvg: ", false );
+	DriverInterface::debug.printFloat( to_float( newHistAvg ), 7, true );
+
+	DriverInterface::debug.printLine( "\tenergyPerStorageCycle:\t\t", false );
+	DriverInterface::debug.printFloat( to_float( storageCycle ), 7, true );
+
+	DriverInterface::debug.printLine( "\tExpected average per slot:\t", false );
+	DriverInterface::debug.printFloat( to_float( expectedAveragePerSlot ), 7, true );
+
+	DriverInterface::debug.printLine( "\tadaptive_slices:\t\t", false );
+	DriverInterface::debug.printFloat( adaptive_slices, 4, true );
+	DriverInterface::debug.printLine( "\n", false );
+#endif
+
+}
+
+
+template <const std::size_t N, typename T, typename Platform>
+void EWMA<N, T, Platform>::initialize()
+{
+	historicalAverage.clear();
+	current_slice = 0;
+}
+
+
+template <const std::size_t N, typename T, typename Platform>
+void EWMA<N, T, Platform>::setDutyCycle()
+{
+	platform.resetClock();
+	platform.sleep( sleepTime );
+}
+
+
+template <const std::size_t N, typename T, typename Platform>
+float EWMA<N, T, Platform>::do_all_the_magic()
+{
+	if ( current_slice == static_cast<unsigned int>( adaptive_slices - 1 ) )
+	{
+		calculateAdaptiveSlices();
+		setDutyCycle();
+		current_slice = 0;
+
+		return to_float( energy_current_slot );
+	}
+	else
+	{
+#ifdef DEBUG
+		DriverInterface::debug.printLine( "current_slice: ", false );
+		DriverInterface::debug.printFloat( current_slice, 3, true );
+#endif
+
+		++current_slice;
+		setDutyCycle();
+
+		return platform.getLuminance();
+	}
+}
+
 #endif /* end of include guard: EWMA_H_PB1IR8OZ */
@@ -0,0 +1,127 @@
+/*
+ * EnergyLog.h
+ *
+ *  Created on: 2026-10-17
+ *      Author: agent
+ */
+
+#ifndef ENERGYLOG_H_K7TQ2ZWD
+#define ENERGYLOG_H_K7TQ2ZWD
+
+#include <stdint.h>
+
+/**
+ * Accounts the time and energy of the phases of a wakeup.
+ *
+ * The application switches the phase with `enter()` whenever it starts a
+ * new piece of work. The time between two switches is measured with the
+ * cycle counter of the core and charged to the phase that was active. At the
+ * end of a wakeup `commit()` stores the time and the estimated energy of
+ * every phase as one record in a ring, from where it is read out over radio.
+ *
+ * The energy is estimated from the time and a nominal power per phase, see
+ * `power`. The cycle counter stops in the energy modes, so time the core
+ * sleeps within a phase, e.g. while the radio sends in EM1, is measured by
+ * the application and added with `charge()`.
+ */
+class EnergyLog
+{
+public:
+
+	enum Phase
+	{
+		sensor,      ///< reading the sensors
+		prediction,  ///< the prediction algorithm
+		radio,       ///< transmission, including the waits in EM1
+		sleepEntry,  ///< reprogramming the RTC before sleeping
+		idle         ///< not charged
+	};
+
+	static const uint8_t phases = idle;  ///< number of charged phases
+
+	/**
+	 * One wakeup.
+	 *
+	 * Ordered by size, so there is no padding between the fields.
+	 */
+	struct Record
+	{
+		uint32_t time[phases];    ///< time per phase in @f$ \mu s @f$
+		uint16_t energy[phases];  ///< energy per phase in @f$ \mu J @f$, saturates
+		uint16_t sequence;        ///< number of the wakeup since reset
+	};
+
+	static const uint8_t size = 16;  ///< records retained
+
+	/**
+	 * Nominal power per phase in @f$ \mu W @f$ at 3 V.
+	 */
+	static const uint32_t power[phases];
+
+	EnergyLog();
+
+	/**
+	 * Starts the cycle counter of the core.
+	 */
+	void initialize();
+
+	/**
+	 * Charges the time since the last switch to the current phase and
+	 * switches to another one.
+	 *
+	 * @return The phase that was active, so nested work can switch back.
+	 */
+	Phase enter( const Phase phase );
+
+	/**
+	 * Charges time the core slept in an energy mode to the current phase.
+	 */
+	void charge( const uint32_t microseconds );
+
+	/**
+	 * Stores the phases charged since the last commit as a record.
+	 *
+	 * If the ring is full, the oldest record is overwritten.
+	 */
+	void commit();
+
+	/**
+	 * Drops the records, e.g. after they have been read out.
+	 */
+	void clear()
+	{
+		stored = 0;
+	}
+
+	uint8_t count() const
+	{
+		return stored;
+	}
+
+	bool full() const
+	{
+		return stored == size;
+	}
+
+	/**
+	 * @return The record @f$ i @f$, the oldest one is 0.
+	 */
+	const Record& operator[]( const uint8_t i ) const
+	{
+		return records[( head + size - stored + i ) % size];
+	}
+
+private:
+
+	Record   records[size];
+	uint8_t  head;    ///< where the next record is stored
+	uint8_t  stored;  ///< records in the ring
+	uint16_t sequence;
+
+	Phase    current;
+	uint32_t since;            ///< cycle counter at the last switch
+	uint32_t cycles[phases];   ///< charged since the last commit
+	uint32_t cyclesPerMicrosecond;
+};
+
+#endif /* end of include guard: ENERGYLOG_H_K7TQ2ZWD */
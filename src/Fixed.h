@@ -0,0 +1,199 @@
+/*
+ * Fixed.h
+ *
+ *  Created on: 2026-10-17
+ *      Author: agent
+ */
+
+#ifndef FIXED_H_K3RV8QZD
+#define FIXED_H_K3RV8QZD
+
+#include <stdint.h>
+#include <limits>  ///< for `numeric_limits`
+
+/**
+ * Signed fixed-point number with @f$ F @f$ fractional bits.
+ *
+ * The value is stored in a 32 bit integer, the remaining @f$ 31-F @f$ bits
+ * hold the integer part, e.g. `Fixed<16>` is a Q16.16 and `Fixed<24>` a
+ * Q8.24 number. It is a drop-in replacement for `float` on targets without
+ * an FPU, where every floating point operation is a call into the soft-float
+ * library.
+ *
+ * All operations saturate at the limits of the representable range instead
+ * of overflowing. Integers convert implicitly, floating point values only
+ * explicitly, since that conversion is expensive without an FPU.
+ *
+ * @param The number of fractional bits.
+ */
+template <const unsigned int F> class Fixed
+{
+	int32_t value;  ///< raw representation, the value times @f$ 2^F @f$
+
+	static const int64_t one = static_cast<int64_t>( 1 ) << F;
+
+	/**
+	 * Clamps a wide intermediate result to the 32 bit range.
+	 */
+	static int32_t saturate( const int64_t v )
+	{
+		if ( v > std::numeric_limits<int32_t>::max() )
+			return std::numeric_limits<int32_t>::max();
+
+		if ( v < std::numeric_limits<int32_t>::min() )
+			return std::numeric_limits<int32_t>::min();
+
+		return static_cast<int32_t>( v );
+	}
+
+	/**
+	 * Converts a floating point value with rounding and saturation.
+	 */
+	static int32_t convert( const double d )
+	{
+		const double v = d * one;
+
+		if ( v >= std::numeric_limits<int32_t>::max() )
+			return std::numeric_limits<int32_t>::max();
+
+		if ( v <= std::numeric_limits<int32_t>::min() )
+			return std::numeric_limits<int32_t>::min();
+
+		return static_cast<int32_t>( v < 0 ? v - .5 : v + .5 );
+	}
+
+public:
+
+	static const unsigned int fraction_bits = F;
+
+	Fixed() : value( 0 ) {}
+
+	Fixed( const int i ) : value( saturate( i * one ) ) {}
+
+	explicit Fixed( const float f ) : value( convert( f ) ) {}
+
+	explicit Fixed( const double d ) : value( convert( d ) ) {}
+
+	/**
+	 * Creates a number from its raw representation.
+	 *
+	 * @param r The value times @f$ 2^F @f$.
+	 */
+	static Fixed from_raw( const int32_t r )
+	{
+		Fixed f;
+		f.value = r;
+		return f;
+	}
+
+	/**
+	 * @return The value times @f$ 2^F @f$.
+	 */
+	int32_t raw() const
+	{
+		return value;
+	}
+
+	float to_float() const
+	{
+		return static_cast<float>( value ) / one;
+	}
+
+	Fixed& operator+=( const Fixed& other )
+	{
+		value = saturate( static_cast<int64_t>( value ) + other.value );
+		return *this;
+	}
+
+	Fixed& operator-=( const Fixed& other )
+	{
+		value = saturate( static_cast<int64_t>( value ) - other.value );
+		return *this;
+	}
+
+	/**
+	 * Multiplication rounded to the nearest representable value.
+	 */
+	Fixed& operator*=( const Fixed& other )
+	{
+		value = saturate( ( static_cast<int64_t>( value ) * other.value + one / 2 ) >> F );
+		return *this;
+	}
+
+	Fixed& operator*=( const int i )
+	{
+		value = saturate( static_cast<int64_t>( value ) * i );
+		return *this;
+	}
+
+	/**
+	 * Division, a division by zero saturates according to the sign.
+	 */
+	Fixed& operator/=( const Fixed& other )
+	{
+		if ( other.value )
+			value = saturate( static_cast<int64_t>( value ) * one / other.value );
+		else
+			value = value < 0 ? std::numeric_limits<int32_t>::min() : std::numeric_limits<int32_t>::max();
+		return *this;
+	}
+
+	/**
+	 * Division by an integer, which needs no widening to 64 bit.
+	 */
+	Fixed& operator/=( const int i )
+	{
+		if ( i )
+			value = saturate( static_cast<int64_t>( value ) / i );
+		else
+			value = value < 0 ? std::numeric_limits<int32_t>::min() : std::numeric_limits<int32_t>::max();
+		return *this;
+	}
+
+	Fixed operator-() const
+	{
+		return from_raw( saturate( -static_cast<int64_t>( value ) ) );
+	}
+
+	friend Fixed operator+( Fixed a, const Fixed& b ) { return a += b; }
+	friend Fixed operator-( Fixed a, const Fixed& b ) { return a -= b; }
+	friend Fixed operator*( Fixed a, const Fixed& b ) { return a *= b; }
+	friend Fixed operator*( Fixed a, const int b )    { return a *= b; }
+	friend Fixed operator/( Fixed a, const Fixed& b ) { return a /= b; }
+	friend Fixed operator/( Fixed a, const int b )    { return a /= b; }
+
+	friend bool operator==( const Fixed& a, const Fixed& b ) { return a.value == b.value; }
+	friend bool operator!=( const Fixed& a, const Fixed& b ) { return a.value != b.value; }
+	friend bool operator< ( const Fixed& a, const Fixed& b ) { return a.value <  b.value; }
+	friend bool operator> ( const Fixed& a, const Fixed& b ) { return a.value >  b.value; }
+	friend bool operator<=( const Fixed& a, const Fixed& b ) { return a.value <= b.value; }
+	friend bool operator>=( const Fixed& a, const Fixed& b ) { return a.value >= b.value; }
+};
+
+typedef Fixed<16> q16_16_t;  ///< range @f$ \pm 32768 @f$, resolution @f$ 2^{-16} @f$
+typedef Fixed<24> q8_24_t;   ///< range @f$ \pm 128 @f$, resolution @f$ 2^{-24} @f$
+
+
+namespace std
+{
+	/**
+	 * Properties of the fixed-point type.
+	 *
+	 * Most notably it is exact, so running sums do not drift.
+	 */
+	template <const unsigned int F> class numeric_limits< Fixed<F> >
+	{
+	public:
+		static const bool is_specialized = true;
+		static const bool is_signed      = true;
+		static const bool is_integer     = false;
+		static const bool is_exact       = true;
+
+		static Fixed<F> min()     { return Fixed<F>::from_raw( 1 ); }
+		static Fixed<F> max()     { return Fixed<F>::from_raw( numeric_limits<int32_t>::max() ); }
+		static Fixed<F> lowest()  { return Fixed<F>::from_raw( numeric_limits<int32_t>::min() ); }
+		static Fixed<F> epsilon() { return Fixed<F>::from_raw( 1 ); }
+	};
+}
+
+#endif /* end of include guard: FIXED_H_K3RV8QZD */
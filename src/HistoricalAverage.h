@@ -10,12 +10,16 @@
 
 #include <cstddef>
 #include <algorithm>
+#include <limits>
 
 /**
  * Class to store the historical average.
  *
  * Templated storage class to hold the historical average.
  *
+ * The sum of all elements is kept up to date in `push()` and `fill()`, so
+ * `sum()` and `average()` do not need to scan the buffer.
+ *
  * @param The number of elements in the list. Needs to be provided when an
  * object of this class is instantiated.
  *
@@ -25,6 +29,19 @@ template <const std::size_t N, typename T> class HistoricalAverage
 {
 	T  buffer[N]; ///< main storage array
 	T* ptr;       ///< pointer used in the `push()` and `pop()` methods
+	T  total;     ///< running sum of all elements
+
+	std::size_t count;  ///< number of elements stored through `push()` or `fill()`
+
+	/**
+	 * Recomputes the running sum by scanning the whole buffer.
+	 */
+	void resync()
+	{
+		total = 0;
+		for ( std::size_t i = 0; i < N; ++i )
+			total += *( buffer + i );
+	}
 
 public:
 
@@ -33,7 +50,7 @@ public:
 	 *
 	 * Initialises all elements with zero.
 	 */
-	HistoricalAverage() : ptr( buffer )
+	HistoricalAverage() : ptr( buffer ), total( 0 ), count( 0 )
 	{
 		std::fill( buffer, buffer + N, T( 0 ) );
 	}
@@ -42,12 +59,28 @@ public:
 	 * Initialises with a default value.
 	 *
 	 * All elements of the array are initialised with the value provided.
+	 * Afterwards the array counts as completely filled.
 	 *
 	 * @param t The value used for initialisation.
 	 */
 	void fill( const T& t )
 	{
 		std::fill( buffer, buffer + N, T( t ) );
+		count = N;
+		resync();
+	}
+
+	/**
+	 * Resets the array to the state after construction.
+	 *
+	 * All elements are set to zero and no element counts as stored.
+	 */
+	void clear()
+	{
+		std::fill( buffer, buffer + N, T( 0 ) );
+		ptr   = buffer;
+		total = 0;
+		count = 0;
 	}
 
 	/**
@@ -64,16 +97,41 @@ public:
 		return N;
 	}
 
+	/**
+	 * The number of elements which have already been stored.
+	 *
+	 * @return Number of values stored with `push()`, at most `size()`.
+	 */
+	std::size_t filled() const
+	{
+		return count;
+	}
+
 	/**
 	 * Stores a value in the array.
 	 *
 	 * If stored value overwrites the oldest value.
+	 *
+	 * The running sum is corrected by the difference of the new and the
+	 * overwritten value. For inexact types like `float` it is recomputed
+	 * once per revolution of the write pointer to stop rounding errors from
+	 * accumulating.
 	 */
 	void push( const T& t )
 	{
-		*ptr = t;
+		total += t - *ptr;
+		*ptr   = t;
+
+		if ( count < N )
+			++count;
+
 		if ( ++ptr >= ( buffer + N ) )
+		{
 			ptr = buffer;
+
+			if ( !std::numeric_limits<T>::is_exact )
+				resync();
+		}
 	}
 
 	/**
@@ -104,10 +162,7 @@ public:
 	 */
 	const T sum() const
 	{
-		T t = 0;
-		for ( std::size_t i = 0; i < N; ++i )
-			t += *( buffer + i );
-		return t;
+		return total;
 	}
 
 	/**
@@ -124,6 +179,33 @@ public:
 		return sum() / size();
 	}
 
+	/**
+	 * Computes the sum of the values which have already been stored.
+	 *
+	 * The zero padding does not contribute to the running sum, hence this
+	 * is the same as `sum()`. It is the counterpart to `average_valid()`.
+	 *
+	 * @return The sum of all stored values.
+	 */
+	const T sum_valid() const
+	{
+		return total;
+	}
+
+	/**
+	 * Computes the average over the values which have already been stored.
+	 *
+	 * Unlike `average()` the result is correct before the array has been
+	 * filled completely, since it is divided by the number of stored values
+	 * instead of the capacity.
+	 *
+	 * @return The average over all stored values, zero if none is stored.
+	 */
+	const T average_valid() const
+	{
+		return count ? sum_valid() / count : 0;
+	}
+
 };
 
 
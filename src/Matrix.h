@@ -0,0 +1,158 @@
+/*
+ * Matrix.h
+ *
+ *  Created on: 2026-10-17
+ *      Author: agent
+ */
+
+#ifndef MATRIX_H_P4JX9CWA
+#define MATRIX_H_P4JX9CWA
+
+#include <cstddef>    ///< for `size_t`
+#include <algorithm>  ///< for `fill`
+
+/**
+ * Alignment of the matrix storage in bytes.
+ *
+ * Defaults to the size of a cache line of common host processors. Targets
+ * without a data cache can lower it in the `Makefile` to save memory.
+ */
+#ifndef MATRIX_ALIGNMENT
+#define MATRIX_ALIGNMENT 64
+#endif
+
+/**
+ * A two-dimensional container with fixed size.
+ *
+ * All elements are stored in one contiguous, aligned block in row-major
+ * order, without any bookkeeping between the rows. A row is a contiguous
+ * sequence of elements, a column is accessed through a view with a stride
+ * of @f$ C @f$ elements.
+ *
+ * @param The type of storage for the elements, e.g. `int` or `float`.
+ * @param The number of rows.
+ * @param The number of columns.
+ */
+template <typename T, const std::size_t R, const std::size_t C> class Matrix
+{
+	T buffer[R * C] __attribute__(( aligned( MATRIX_ALIGNMENT ) ));  ///< main storage array
+
+public:
+
+	typedef       T* pointer;
+	typedef const T* const_pointer;
+	typedef       T& reference;
+	typedef const T& const_reference;
+
+	/**
+	 * A column of the matrix.
+	 *
+	 * Refers to the elements of the matrix, it does not copy them.
+	 */
+	class const_column
+	{
+		const_pointer base;  ///< first element of the column
+
+	public:
+
+		explicit const_column( const_pointer b ) : base( b ) {}
+
+		const_reference operator[]( const std::size_t r ) const
+		{
+			return base[r * C];
+		}
+
+		std::size_t size() const
+		{
+			return R;
+		}
+
+		/**
+		 * Computes the sum of all elements of the column.
+		 */
+		const T sum() const
+		{
+			T t = 0;
+			for ( std::size_t r = 0; r < R; ++r )
+				t += base[r * C];
+			return t;
+		}
+	};
+
+	/**
+	 * Constructor
+	 *
+	 * Initialises all elements with zero.
+	 */
+	Matrix()
+	{
+		std::fill( buffer, buffer + R * C, T( 0 ) );
+	}
+
+	/**
+	 * Initialises all elements with the value provided.
+	 *
+	 * @param t The value used for initialisation.
+	 */
+	void fill( const T& t )
+	{
+		std::fill( buffer, buffer + R * C, T( t ) );
+	}
+
+	std::size_t rows() const
+	{
+		return R;
+	}
+
+	std::size_t columns() const
+	{
+		return C;
+	}
+
+	pointer data()
+	{
+		return buffer;
+	}
+
+	const_pointer data() const
+	{
+		return buffer;
+	}
+
+	/**
+	 * A row of the matrix.
+	 *
+	 * @return Pointer to the first of @f$ C @f$ contiguous elements.
+	 */
+	pointer row( const std::size_t r )
+	{
+		return buffer + r * C;
+	}
+
+	const_pointer row( const std::size_t r ) const
+	{
+		return buffer + r * C;
+	}
+
+	/**
+	 * A column of the matrix.
+	 *
+	 * @return View of the @f$ R @f$ elements with a stride of @f$ C @f$.
+	 */
+	const_column column( const std::size_t c ) const
+	{
+		return const_column( buffer + c );
+	}
+
+	reference operator()( const std::size_t r, const std::size_t c )
+	{
+		return buffer[r * C + c];
+	}
+
+	const_reference operator()( const std::size_t r, const std::size_t c ) const
+	{
+		return buffer[r * C + c];
+	}
+};
+
+#endif /* end of include guard: MATRIX_H_P4JX9CWA */
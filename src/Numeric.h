@@ -0,0 +1,183 @@
+/*
+ * Numeric.h
+ *
+ *  Created on: 2026-10-17
+ *      Author: agent
+ */
+
+#ifndef NUMERIC_H_W7TQ2MXE
+#define NUMERIC_H_W7TQ2MXE
+
+#include <cmath>  ///< for `ceil`
+#include "Fixed.h"
+
+/**
+ * Arithmetic building blocks that differ between number representations.
+ *
+ * The containers and algorithms are written against this policy, so they
+ * can be instantiated with `float` as well as with a fixed-point type. The
+ * generic version uses the built-in operators.
+ *
+ * @param The type of the numbers, e.g. `float` or `q16_16_t`.
+ */
+template <typename T> struct NumericPolicy
+{
+	/**
+	 * Multiply-accumulate.
+	 *
+	 * @return @f$ acc + a \cdot b @f$
+	 */
+	static T mac( const T& acc, const T& a, const T& b )
+	{
+		return acc + a * b;
+	}
+
+	/**
+	 * The reciprocal of a constant.
+	 *
+	 * Since @f$ n @f$ is known at compile time, the value is folded into a
+	 * constant and dividing by @f$ n @f$ becomes a multiplication.
+	 *
+	 * @return @f$ \frac{1}{n} @f$
+	 */
+	template <const unsigned int n> static T reciprocal()
+	{
+		return T( 1 ) / static_cast<T>( n );
+	}
+
+	/**
+	 * The smallest integer not less than the value.
+	 */
+	static int ceil( const T& t )
+	{
+		return static_cast<int>( std::ceil( t ) );
+	}
+
+	static T from_float( const float f )
+	{
+		return static_cast<T>( f );
+	}
+
+	static float to_float( const T& t )
+	{
+		return static_cast<float>( t );
+	}
+};
+
+
+/**
+ * Fixed-point version of the arithmetic building blocks.
+ *
+ * @param The number of fractional bits.
+ */
+template <const unsigned int F> struct NumericPolicy< Fixed<F> >
+{
+	/**
+	 * Saturating multiply-accumulate.
+	 *
+	 * The product is kept at full precision and only rounded once it is
+	 * added to the accumulator.
+	 *
+	 * @return @f$ acc + a \cdot b @f$
+	 */
+	static Fixed<F> mac( const Fixed<F>& acc, const Fixed<F>& a, const Fixed<F>& b )
+	{
+		const int64_t one     = static_cast<int64_t>( 1 ) << F;
+		const int64_t product = static_cast<int64_t>( a.raw() ) * b.raw();
+		const int64_t v       = ( acc.raw() * one + product + one / 2 ) >> F;
+
+		if ( v > std::numeric_limits<int32_t>::max() )
+			return std::numeric_limits< Fixed<F> >::max();
+
+		if ( v < std::numeric_limits<int32_t>::min() )
+			return std::numeric_limits< Fixed<F> >::lowest();
+
+		return Fixed<F>::from_raw( static_cast<int32_t>( v ) );
+	}
+
+	/**
+	 * The reciprocal of a constant.
+	 *
+	 * Computed from template arguments only, so no division is executed at
+	 * runtime.
+	 *
+	 * @return @f$ \frac{1}{n} @f$ rounded to the nearest representable value
+	 */
+	template <const unsigned int n> static Fixed<F> reciprocal()
+	{
+		return Fixed<F>::from_raw( static_cast<int32_t>( ( ( static_cast<int64_t>( 1 ) << F ) + n / 2 ) / n ) );
+	}
+
+	/**
+	 * The smallest integer not less than the value.
+	 */
+	static int ceil( const Fixed<F>& t )
+	{
+		return static_cast<int>( ( static_cast<int64_t>( t.raw() ) + ( static_cast<int64_t>( 1 ) << F ) - 1 ) >> F );
+	}
+
+	static Fixed<F> from_float( const float f )
+	{
+		return Fixed<F>( f );
+	}
+
+	static float to_float( const Fixed<F>& t )
+	{
+		return t.to_float();
+	}
+};
+
+
+/**
+ * Converts a number to `float`, e.g. for printing.
+ */
+template <typename T> float to_float( const T& t )
+{
+	return NumericPolicy<T>::to_float( t );
+}
+
+/**
+ * Converts a `float` to the given number type.
+ */
+template <typename T> T from_float( const float f )
+{
+	return NumericPolicy<T>::from_float( f );
+}
+
+/**
+ * Conversion between two number types.
+ *
+ * Different types are converted by way of `float`.
+ */
+template <typename To, typename From> struct NumericCast
+{
+	static To convert( const From& f )
+	{
+		return from_float<To>( to_float( f ) );
+	}
+};
+
+/**
+ * Conversion to the same type, which is free.
+ */
+template <typename T> struct NumericCast<T, T>
+{
+	static const T& convert( const T& t )
+	{
+		return t;
+	}
+};
+
+/**
+ * Converts a number to another number type.
+ *
+ * Used where a configuration value of type `numeric_t` meets an algorithm
+ * instantiated with a different type. If both types are the same, nothing
+ * is computed.
+ */
+template <typename To, typename From> To numeric_cast( const From& f )
+{
+	return NumericCast<To, From>::convert( f );
+}
+
+#endif /* end of include guard: NUMERIC_H_W7TQ2MXE */
@@ -0,0 +1,32 @@
+/*
+ * Platform.h
+ *
+ *  Created on: 2026-10-17
+ *      Author: agent
+ */
+
+#ifndef PLATFORM_H_Q5ZC8LRN
+#define PLATFORM_H_Q5ZC8LRN
+
+/**
+ * Access of the algorithms to the hardware.
+ *
+ * The algorithms take the platform as a template parameter and keep a copy
+ * of it. A platform has to provide these members:
+ *
+ * - `float getLuminance()`, the sensor source, luminance radiation in
+ *   joule.
+ * - `float getStorageVoltage()`, the sensor source, the voltage of the
+ *   energy storage in @f$ V @f$.
+ * - `void resetClock()`, restarts the clock at its base time.
+ * - `void sleep( unsigned int seconds )`, sets the alarm and enters the
+ *   low power mode until it fires.
+ *
+ * Since the platform is resolved at compile time, the calls are inlined and
+ * cost nothing compared to calling the drivers directly. The firmware uses
+ * `SentioPlatform`, which forwards to the drivers of the sensor node. The
+ * simulator replays recorded traces against a virtual clock instead.
+ */
+class SentioPlatform;
+
+#endif /* end of include guard: PLATFORM_H_Q5ZC8LRN */
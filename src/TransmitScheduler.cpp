@@ -0,0 +1,39 @@
+/*
+ * TransmitScheduler.cpp
+ *
+ *  Created on: 2026-10-17
+ *      Author: agent
+ */
+
+#include <limits>
+
+#include "Configuration.h"
+#include "TransmitScheduler.h"
+
+const float TransmitScheduler::margin = .1;
+
+bool TransmitScheduler::transmit( const UplinkBatch& batch, const float storageVoltage,
+	const float forecast, const float demand )
+{
+	if ( !batch.count() )
+		return false;
+
+	const float empty = to_float( Configuration::energyStorageEmpty );
+	const float full  = to_float( Configuration::energyStorageFull );
+	const float close = margin * ( full - empty );
+
+	if ( storageVoltage < empty + close )
+		return false;
+
+	if ( storageVoltage > full - close )
+		return true;
+
+	// a forecast that is not a number or saturated the number type promises
+	// nothing
+	const float saturated = to_float( std::numeric_limits<numeric_t>::max() );
+
+	if ( !( forecast >= demand ) || forecast >= saturated )
+		return batch.full();
+
+	return batch.due();
+}
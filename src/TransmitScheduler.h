@@ -0,0 +1,53 @@
+/*
+ * TransmitScheduler.h
+ *
+ *  Created on: 2026-10-17
+ *      Author: agent
+ */
+
+#ifndef TRANSMITSCHEDULER_H_W2HD6QSA
+#define TRANSMITSCHEDULER_H_W2HD6QSA
+
+#include "UplinkBatch.h"
+
+/**
+ * Decides when the buffered readings are sent.
+ *
+ * The radio is the most expensive part of a wakeup, so it is moved to the
+ * times with plenty of energy. Depending on the voltage of the energy
+ * storage and the forecast of the predictor the readings are
+ *
+ * - deferred while the storage is close to `energyStorageEmpty`. Readings
+ *   are still taken, if the buffer overflows the oldest ones are lost.
+ * - coalesced while the forecast does not cover the demand of the node.
+ *   They are only sent when the buffer is full. A forecast that is not a
+ *   number or saturated the number type of the predictor counts as not
+ *   covering the demand.
+ * - sent as soon as the buffer is due while the forecast covers the demand.
+ *   A backlog goes out completely.
+ * - sent at every wakeup while the storage is close to `energyStorageFull`,
+ *   since the harvested energy would be wasted otherwise.
+ */
+class TransmitScheduler
+{
+public:
+
+	/**
+	 * Distance to the voltages of an empty and a full storage that counts
+	 * as close, as fraction of the difference between them.
+	 */
+	static const float margin;
+
+	/**
+	 * @param batch          The buffered readings.
+	 * @param storageVoltage Voltage of the energy storage in @f$ V @f$.
+	 * @param forecast       Energy predicted for the next slot.
+	 * @param demand         Energy the node needs in the next slot.
+	 *
+	 * @return Whether the readings should be sent now.
+	 */
+	static bool transmit( const UplinkBatch& batch, const float storageVoltage,
+		const float forecast, const float demand );
+};
+
+#endif /* end of include guard: TRANSMITSCHEDULER_H_W2HD6QSA */
@@ -0,0 +1,215 @@
+/*
+ * UplinkBatch.cpp
+ *
+ *  Created on: 2026-10-17
+ *      Author: agent
+ */
+
+#include "UplinkBatch.h"
+
+namespace
+{
+	/**
+	 * The fields of a reading in the order they are encoded.
+	 */
+	void toFields( const UplinkBatch::Reading& r, int32_t *f )
+	{
+		f[0] = r.temperature;
+		f[1] = r.humidity;
+		f[2] = r.adaptive_slices;
+		f[3] = r.sleep_time;
+		f[4] = r.battery_level;
+	}
+
+	void fromFields( const int32_t *f, UplinkBatch::Reading& r )
+	{
+		r.temperature     = static_cast<int16_t>( f[0] );
+		r.humidity        = static_cast<uint16_t>( f[1] );
+		r.adaptive_slices = static_cast<uint16_t>( f[2] );
+		r.sleep_time      = static_cast<uint16_t>( f[3] );
+		r.battery_level   = static_cast<uint16_t>( f[4] );
+	}
+
+	int32_t round( const float f )
+	{
+		return static_cast<int32_t>( f < 0 ? f - .5f : f + .5f );
+	}
+
+	uint16_t clampUnsigned( const int32_t i )
+	{
+		return i < 0 ? 0 : i > 0xffff ? 0xffff : static_cast<uint16_t>( i );
+	}
+
+	/**
+	 * Writes the zigzag encoded difference as a variable length number.
+	 *
+	 * @return Bytes written.
+	 */
+	uint8_t putDelta( const int32_t delta, uint8_t *out )
+	{
+		uint32_t z = delta < 0 ? ( static_cast<uint32_t>( -delta ) << 1 ) - 1 : static_cast<uint32_t>( delta ) << 1;
+		uint8_t  n = 0;
+
+		while ( z >= 0x80 )
+		{
+			out[n++] = static_cast<uint8_t>( z | 0x80 );
+			z >>= 7;
+		}
+
+		out[n++] = static_cast<uint8_t>( z );
+
+		return n;
+	}
+
+	/**
+	 * Reads a difference written by `putDelta()`.
+	 *
+	 * @return Bytes read, zero if the number does not end within `size`.
+	 */
+	uint8_t getDelta( const uint8_t *in, const uint8_t size, int32_t& delta )
+	{
+		uint32_t z     = 0;
+		uint8_t  shift = 0;
+
+		for ( uint8_t n = 0; n < size && shift < 32; shift += 7 )
+		{
+			const uint8_t byte = in[n++];
+
+			z |= static_cast<uint32_t>( byte & 0x7f ) << shift;
+
+			if ( !( byte & 0x80 ) )
+			{
+				delta = z & 1 ? -static_cast<int32_t>( ( z + 1 ) >> 1 ) : static_cast<int32_t>( z >> 1 );
+				return n;
+			}
+		}
+
+		return 0;
+	}
+}
+
+
+UplinkBatch::UplinkBatch( const uint8_t l, const uint32_t a ) :
+	stored( 0 ),
+	span  ( 0 ),
+	limit ( l < capacity ? l : capacity ),
+	maxAge( a )
+{
+}
+
+
+UplinkBatch::Reading UplinkBatch::quantize( const float temperature, const float humidity,
+	const unsigned int adaptiveSlices, const unsigned int sleepTime, const float batteryLevel )
+{
+	const int32_t t = round( temperature * 10 );
+
+	Reading r;
+
+	r.temperature     = static_cast<int16_t>( t < -32768 ? -32768 : t > 32767 ? 32767 : t );
+	r.humidity        = clampUnsigned( round( humidity * 10 ) );
+	r.adaptive_slices = clampUnsigned( adaptiveSlices );
+	r.sleep_time      = clampUnsigned( sleepTime );
+	r.battery_level   = clampUnsigned( round( batteryLevel * 1000 ) );
+
+	return r;
+}
+
+
+void UplinkBatch::push( const Reading& reading )
+{
+	if ( stored == capacity )
+		drop( 1 );
+
+	readings[stored++] = reading;
+	span += reading.sleep_time;
+}
+
+
+bool UplinkBatch::due() const
+{
+	return stored && ( stored >= limit || age() >= maxAge );
+}
+
+
+uint8_t UplinkBatch::encode( uint8_t *out, const uint8_t size, uint8_t& bytes ) const
+{
+	int32_t previous[fields] = { 0 };
+	uint8_t n                = 0;
+
+	bytes = 0;
+
+	for ( ; n < stored; ++n )
+	{
+		int32_t current[fields];
+		uint8_t buffer[maxEncodedSize];
+		uint8_t length = 0;
+
+		toFields( readings[n], current );
+
+		for ( uint8_t f = 0; f < fields; ++f )
+			length += putDelta( current[f] - previous[f], buffer + length );
+
+		if ( bytes + length > size )
+			break;
+
+		for ( uint8_t i = 0; i < length; ++i )
+			out[bytes++] = buffer[i];
+
+		for ( uint8_t f = 0; f < fields; ++f )
+			previous[f] = current[f];
+	}
+
+	return n;
+}
+
+
+uint8_t UplinkBatch::decode( const uint8_t *in, const uint8_t size, const uint8_t count, Reading *out )
+{
+	int32_t value[fields] = { 0 };
+	uint8_t position      = 0;
+
+	for ( uint8_t n = 0; n < count; ++n )
+	{
+		for ( uint8_t f = 0; f < fields; ++f )
+		{
+			int32_t       delta;
+			const uint8_t length = getDelta( in + position, size - position, delta );
+
+			if ( !length )
+				return n;
+
+			value[f] += delta;
+			position += length;
+		}
+
+		fromFields( value, out[n] );
+	}
+
+	return count;
+}
+
+
+uint32_t UplinkBatch::age( const Reading *readings, const uint8_t count, const uint8_t i )
+{
+	uint32_t sum = 0;
+
+	for ( uint8_t n = i; n + 1 < count; ++n )
+		sum += readings[n].sleep_time;
+
+	return sum;
+}
+
+
+void UplinkBatch::drop( uint8_t n )
+{
+	if ( n > stored )
+		n = stored;
+
+	for ( uint8_t i = 0; i < n; ++i )
+		span -= readings[i].sleep_time;
+
+	for ( uint8_t i = n; i < stored; ++i )
+		readings[i - n] = readings[i];
+
+	stored -= n;
+}
@@ -0,0 +1,149 @@
+/*
+ * UplinkBatch.h
+ *
+ *  Created on: 2026-10-17
+ *      Author: agent
+ */
+
+#ifndef UPLINKBATCH_H_F4NC8XRE
+#define UPLINKBATCH_H_F4NC8XRE
+
+#include <stdint.h>
+
+/**
+ * Buffers readings and sends several of them in one packet.
+ *
+ * The readings are stored in fixed-point. In a packet every field is encoded
+ * as the difference to the same field of the previous reading, the first
+ * reading to zero. The differences are mapped to unsigned numbers by zigzag
+ * encoding, @f$ 0, -1, 1, -2, \ldots \mapsto 0, 1, 2, 3, \ldots @f$, and
+ * written as variable length numbers, seven bits per byte with the highest
+ * bit set on all but the last byte. Slowly changing readings hence take
+ * about one byte per field.
+ *
+ * The buffer is due for sending when it holds `limit` readings or when its
+ * oldest reading is older than `maxAge`. When to send is decided by the
+ * `TransmitScheduler`.
+ */
+class UplinkBatch
+{
+public:
+
+	/**
+	 * One reading in fixed-point.
+	 */
+	struct Reading
+	{
+		int16_t  temperature;      ///< value in @f$ 0.1 ^\circ C @f$
+		uint16_t humidity;         ///< value in @f$ 0.1 \% @f$
+		uint16_t adaptive_slices;
+		uint16_t sleep_time;       ///< value in @f$ s @f$
+		uint16_t battery_level;    ///< value in @f$ mV @f$
+	};
+
+	static const uint8_t fields   = 5;   ///< fields of a reading
+	static const uint8_t capacity = 32;  ///< readings buffered at most
+
+	/**
+	 * Bytes of one encoded reading at most, three per field.
+	 */
+	static const uint8_t maxEncodedSize = 3 * fields;
+
+	/**
+	 * @param limit  Readings that make the buffer due, at most `capacity`.
+	 * @param maxAge Age in @f$ s @f$ of the oldest reading that makes the
+	 *               buffer due.
+	 */
+	UplinkBatch( const uint8_t limit, const uint32_t maxAge );
+
+	/**
+	 * Converts a reading to fixed-point, rounding to the nearest value.
+	 */
+	static Reading quantize( const float temperature, const float humidity,
+		const unsigned int adaptiveSlices, const unsigned int sleepTime, const float batteryLevel );
+
+	/**
+	 * Buffers a reading. If the buffer is full, the oldest one is dropped.
+	 */
+	void push( const Reading& reading );
+
+	/**
+	 * @return Whether the buffer holds `limit` readings or the oldest one is
+	 * older than `maxAge`.
+	 */
+	bool due() const;
+
+	/**
+	 * Encodes the oldest readings.
+	 *
+	 * @param out   Destination of the encoded readings.
+	 * @param size  Bytes available in `out`.
+	 * @param bytes Bytes written.
+	 *
+	 * @return Readings encoded, as many as fit.
+	 */
+	uint8_t encode( uint8_t *out, const uint8_t size, uint8_t& bytes ) const;
+
+	/**
+	 * Decodes readings written by `encode()`.
+	 *
+	 * @param in    The encoded readings.
+	 * @param size  Bytes in `in`.
+	 * @param count Readings to decode, at most the size of `out`.
+	 * @param out   Destination of the readings.
+	 *
+	 * @return Readings decoded, less than `count` if `in` is too short.
+	 */
+	static uint8_t decode( const uint8_t *in, const uint8_t size, const uint8_t count, Reading *out );
+
+	/**
+	 * Reconstructs when a reading was taken. The readings carry no time, but
+	 * each one carries the sleep time that followed it.
+	 *
+	 * @param readings Consecutive readings, oldest first.
+	 * @param count    Readings in `readings`.
+	 * @param i        Index of the reading.
+	 *
+	 * @return Time in @f$ s @f$ from reading `i` to the newest reading.
+	 */
+	static uint32_t age( const Reading *readings, const uint8_t count, const uint8_t i );
+
+	/**
+	 * Removes the @f$ n @f$ oldest readings, e.g. after they were sent.
+	 */
+	void drop( uint8_t n );
+
+	uint8_t count() const
+	{
+		return stored;
+	}
+
+	bool full() const
+	{
+		return stored == capacity;
+	}
+
+	const Reading& oldest() const
+	{
+		return readings[0];
+	}
+
+	/**
+	 * @return Time in @f$ s @f$ since the oldest reading.
+	 */
+	uint32_t age() const
+	{
+		return stored ? span - readings[stored - 1].sleep_time : 0;
+	}
+
+private:
+
+	Reading  readings[capacity];  ///< oldest first
+	uint8_t  stored;
+	uint32_t span;   ///< sum of the sleep times of the readings
+
+	const uint8_t  limit;
+	const uint32_t maxAge;
+};
+
+#endif /* end of include guard: UPLINKBATCH_H_F4NC8XRE */
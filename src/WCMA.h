@@ -1,5 +1,5 @@
 /*
- * EWMA.h
+ * WCMA.h
  *
  *  Created on: 2013-07-10
  *      Author: Marco Patzer
@@ -9,25 +9,117 @@
 #define WCMA_H_0INEYXJP
 
 #include <cmath>
-#include "Algorithms.h"
+#include <limits>
+#include "Platform.h"
 #include "Configuration.h"
 #include "Array.h"
+#include "Matrix.h"
 
-typedef Array<float, Configuration::slotsPerDay>   matrix_row_t;
-typedef Array<float, Configuration::retainSamples> array_rs_t;
+#ifdef DEBUG
+#include "DriverInterface.h"
+#endif
 
+/**
+ * Weather-conditioned moving average.
+ *
+ * The dimensions are template parameters, so all loops run over constants
+ * which the compiler can unroll, and several parameter sets can be
+ * instantiated side by side in one program.
+ *
+ * @param Number of slots per day, @f$ N @f$ in the formulas.
+ * @param Number of days retained, @f$ D @f$ in the formulas.
+ * @param Number of samples used for the prediction, @f$ K @f$ in the
+ * formulas.
+ * @param The number type used for the computation, e.g. `float` or
+ * `q16_16_t`.
+ * @param The access to sensors and clock, see `Platform.h`.
+ */
+template <const std::size_t N = Configuration::slotsPerDay,
+		  const std::size_t D = Configuration::retainDays,
+		  const std::size_t K = Configuration::retainSamples,
+		  typename T = numeric_t,
+		  typename Platform = SentioPlatform>
 class WCMA : public Configuration
 {
-	matrix_row_t energy_prediction_matrix[retainDays];
+public:
+
+	typedef Array<T, N, true> day_samples_t;
+	typedef Array<T, K>       array_rs_t;
+	typedef Matrix<T, D + 1, N> prediction_matrix_t;
+
+private:
+
+	/**
+	 * Ring of rows, one per day.
+	 *
+	 * The row at `matrix_head` receives the samples of the current day, the
+	 * following rows hold the past days, from yesterday up to @f$ D @f$ days
+	 * ago. At midnight only `matrix_head` moves back by one, the row of the
+	 * oldest day becomes the one of the new day.
+	 *
+	 * The rows are stored back to back in one contiguous block.
+	 */
+	prediction_matrix_t energy_prediction_matrix;
+	unsigned int        matrix_head;
+
 	array_rs_t   sample_energy_quotient;
-	array_rs_t   time_distance_weight;  //< @f$ P_k=\frac{k}{K} @f$
+	array_rs_t   time_distance_weight;  //< @f$ \frac{P_k}{\sum P} @f$, normalised weights
+
+	/**
+	 * Samples of the last 24 hours.
+	 *
+	 * Holds the current day up to `day_index` and the previous day after
+	 * it. Keeps a running sum for `last_24h_avg()`.
+	 */
+	day_samples_t current_day_samples;
 
-	matrix_row_t current_day_samples;
+	/**
+	 * Sum over the days of the energy prediction matrix for each slot.
+	 *
+	 * Updated by `reorder_prediction_matrix()`, so `meanPastDays()` does
+	 * not need to visit every row.
+	 */
+	Array<T, N> column_sum;
 
 	unsigned int day_index;
 	unsigned int current_slice;
+	unsigned int days_since_resync;  ///< days since `column_sum` was recomputed
 
-	float energy_current_slot;
+	/**
+	 * Recomputes `column_sum` from the energy prediction matrix.
+	 */
+	void resync_column_sum();
+
+	/**
+	 * A row of a past day in the energy prediction matrix.
+	 *
+	 * @param age One for yesterday up to @f$ D @f$.
+	 * @return Pointer to the @f$ N @f$ samples of the day.
+	 */
+	const T* past_day( const std::size_t age ) const
+	{
+		const std::size_t i = matrix_head + age;
+		return energy_prediction_matrix.row( i <= D ? i : i - D - 1 );
+	}
+
+	T energy_current_slot;
+
+	Platform platform;
+
+	/**
+	 * Stores the normalised weights.
+	 *
+	 * The normalisation is done in `float` before the conversion to the
+	 * number type, so the weights always add up to one as closely as the
+	 * type allows.
+	 *
+	 * @param weights Arbitrary non-negative weights, at least one of them
+	 * greater than zero.
+	 *
+	 * @return `false` if a weight is negative or not finite or all of them
+	 * are zero. The previous weights are kept then.
+	 */
+	bool normalize_weights( const float ( &weights )[K] );
 
 public:
 
@@ -38,30 +130,76 @@ public:
 	 * duty-cycle. It can not be smaller than one. One represents one slice
 	 * per slot.
 	 */
-	static int adaptive_slices;
+	int adaptive_slices;
 
 
-	WCMA() {}
-	
+	explicit WCMA( const Platform& p = Platform() ) : platform( p ), adaptive_slices( 1 )
+	{
+		setLinearWeights();
+	}
+
 	/**
-	 * Fills the arrays and energy prediction matrix with sensible values.
+	 * Fills the energy prediction matrix with sensible values.
 	 *
-	 * The luminance is measured once and the arrays are filled with the
-	 * measured values.
+	 * The luminance is measured once and the matrix is filled with the
+	 * measured value. The samples of the current day start out empty, only
+	 * the slots measured since then are taken into account.
 	 */
 	void initialize();
 
 	/**
-	 * The mean value of the past `Configuration::retainDays` days.
+	 * Weights the samples linearly by their distance in time.
+	 *
+	 * @f$ P_k=\frac{k}{K} @f$, the most recent sample has the largest
+	 * weight. This is the default.
+	 */
+	void setLinearWeights();
+
+	/**
+	 * Weights the samples exponentially by their distance in time.
+	 *
+	 * @f$ P_k=b^{K-k} @f$, each sample weighs @f$ b @f$ times the
+	 * following, more recent one.
+	 *
+	 * @param base The factor @f$ b @f$, between zero and one.
+	 *
+	 * @return `false` if the weights are rejected, see `setWeights()`.
+	 */
+	bool setExponentialWeights( const float base );
+
+	/**
+	 * Uses the weights provided.
+	 *
+	 * @param weights @f$ P_1 @f$ to @f$ P_K @f$, from the oldest to the most
+	 * recent sample. They are normalised, only their ratio matters.
+	 *
+	 * @return `false` if a weight is negative or not finite or all of them
+	 * are zero. The previous weights are kept then.
+	 */
+	bool setWeights( const float ( &weights )[K] );
+
+	/**
+	 * @return The normalised weights @f$ \frac{P_k}{\sum P} @f$.
+	 */
+	const array_rs_t& weights() const
+	{
+		return time_distance_weight;
+	}
+
+	/**
+	 * The mean value of the past @f$ D @f$ days.
 	 *
 	 * Calculates the un-weighted mean value of the past days at this
 	 * particular sample index, which corresponds to the same time of the day.
+	 * The sum over the days is cached in `column_sum`, and the division by
+	 * the number of days is a multiplication with a reciprocal computed at
+	 * compile time, so the cost does not depend on the number of days.
 	 *
 	 * @f$ M_D @f$ in the formulas.
 	 *
 	 * @return Mean value of the past days
 	 */
-	float meanPastDays( const size_t day ) const;
+	T meanPastDays( const std::size_t day ) const;
 
 	/**
 	 * The quotient of the past days.
@@ -71,23 +209,26 @@ public:
 	 *
 	 * @f$ V_k=\frac{E(\ldots)}{M_D(\ldots)} @f$
 	 *
-	 * @return Vector with `Configuration::retainSamples` quotient values
+	 * @return Vector with @f$ K @f$ quotient values
 	 */
 	array_rs_t pastDaysQuotient() const;
 
 	/**
 	 * @f$ gap_k=\frac{\vec{V}\times\vec{P}}{\sum P}@f$
 	 *
+	 * The weights are normalised when they are set, so this is a single dot
+	 * product.
+	 *
 	 * @return GAP value
 	 */
-	float gap() const;
+	T gap() const;
 
 	/**
 	 * Calculates the prediction for the next slot.
 	 *
 	 * @return Predicted value for the next slot
 	 */
-	float nextPrediction() const;
+	T nextPrediction() const;
 
 	/**
 	 * Computes the number of slices for the next slot.
@@ -111,14 +252,18 @@ public:
 	 *
 	 * @return Average energy per slot for the last 24 hours.
 	 */
-	float last_24h_avg() const;
+	T last_24h_avg() const;
 
 	/**
 	 * Inserts the current day's array into the energy prediction matrix.
 	 *
-	 * After 24 hours have been passed, the arrays in the energy prediction
-	 * matrix are shifted up by one index and the current day's array is
-	 * inserted to represent the last day's history.
+	 * After 24 hours have been passed, the current day's row becomes the
+	 * last day's history by moving the head of the ring. Nothing is copied.
+	 *
+	 * The sums in `column_sum` are corrected by adding the new day and
+	 * subtracting the evicted one. For inexact types like `float` they are
+	 * recomputed every @f$ D @f$ days to stop rounding errors from
+	 * accumulating.
 	 */
 	void reorder_prediction_matrix();
 
@@ -133,6 +278,306 @@ public:
 	 */
 	float do_all_the_magic();
 
+	/**
+	 * The slice of the current slot.
+	 *
+	 * Zero right after `do_all_the_magic()` started a new slot.
+	 */
+	unsigned int currentSlice() const
+	{
+		return current_slice;
+	}
+
 };
 
+
+template <const std::size_t N, const std::size_t D, const std::size_t K, typename T, typename Platform>
+void WCMA<N, D, K, T, Platform>::initialize()
+{
+	const T val = from_float<T>( platform.getLuminance() );
+
+	current_day_samples.clear();
+
+	energy_prediction_matrix.fill( val );
+	matrix_head = 0;
+
+	resync_column_sum();
+
+	day_index     = 0;
+	current_slice = 0;
+}
+
+
+template <const std::size_t N, const std::size_t D, const std::size_t K, typename T, typename Platform>
+void WCMA<N, D, K, T, Platform>::resync_column_sum()
+{
+	column_sum.fill( 0 );
+
+	for ( std::size_t i = 1; i <= D; ++i )
+	{
+		const T* row = past_day( i );
+
+		for ( std::size_t j = 0; j < N; ++j )
+			column_sum[j] += row[j];
+	}
+
+	days_since_resync = 0;
+}
+
+
+template <const std::size_t N, const std::size_t D, const std::size_t K, typename T, typename Platform>
+bool WCMA<N, D, K, T, Platform>::normalize_weights( const float ( &weights )[K] )
+{
+	float sum = 0;
+
+	for ( std::size_t k = 0; k < K; ++k )
+	{
+		// also false for NaN
+		if ( !( weights[k] >= 0 ) )
+			return false;
+
+		sum += weights[k];
+	}
+
+	if ( !( sum > 0 ) || sum > std::numeric_limits<float>::max() )
+		return false;
+
+	for ( std::size_t k = 0; k < K; ++k )
+		time_distance_weight[k] = from_float<T>( weights[k] / sum );
+
+	return true;
+}
+
+
+template <const std::size_t N, const std::size_t D, const std::size_t K, typename T, typename Platform>
+void WCMA<N, D, K, T, Platform>::setLinearWeights()
+{
+	float weights[K];
+
+	for ( std::size_t k = 0; k < K; ++k )
+		weights[k] = static_cast<float>( k + 1 ) / K;
+
+	normalize_weights( weights );
+}
+
+
+template <const std::size_t N, const std::size_t D, const std::size_t K, typename T, typename Platform>
+bool WCMA<N, D, K, T, Platform>::setExponentialWeights( const float base )
+{
+	float weights[K];
+	float w = 1;
+
+	for ( std::size_t k = K; k; --k )
+		weights[k - 1] = w,
+		w *= base;
+
+	return normalize_weights( weights );
+}
+
+
+template <const std::size_t N, const std::size_t D, const std::size_t K, typename T, typename Platform>
+bool WCMA<N, D, K, T, Platform>::setWeights( const float ( &weights )[K] )
+{
+	return normalize_weights( weights );
+}
+
+
+template <const std::size_t N, const std::size_t D, const std::size_t K, typename T, typename Platform>
+T WCMA<N, D, K, T, Platform>::meanPastDays( const std::size_t day ) const
+{
+	return column_sum[day] * NumericPolicy<T>::template reciprocal<D>();
+}
+
+
+template <const std::size_t N, const std::size_t D, const std::size_t K, typename T, typename Platform>
+typename WCMA<N, D, K, T, Platform>::array_rs_t WCMA<N, D, K, T, Platform>::pastDaysQuotient() const
+{
+	array_rs_t quot;
+
+	/*
+	 * The most recent sample goes into the last element. Slots that have
+	 * not been measured since the start contribute a neutral quotient of
+	 * one.
+	 */
+	for ( std::size_t k = 0; k < K; ++k )
+	{
+		const std::size_t index = current_day_samples.index_last( k );
+
+		quot[K - 1 - k] = k < current_day_samples.filled() ?
+			current_day_samples[index] / meanPastDays( index ) : 1;
+	}
+
+	return quot;
+}
+
+
+template <const std::size_t N, const std::size_t D, const std::size_t K, typename T, typename Platform>
+T WCMA<N, D, K, T, Platform>::gap() const
+{
+	return sample_energy_quotient.dotproduct( time_distance_weight );
+}
+
+
+template <const std::size_t N, const std::size_t D, const std::size_t K, typename T, typename Platform>
+T WCMA<N, D, K, T, Platform>::nextPrediction() const
+{
+	const T alpha = numeric_cast<T>( weightingFactor );
+
+	return alpha * energy_current_slot + gap() * ( 1 - alpha ) * meanPastDays( day_index );
+}
+
+
+template <const std::size_t N, const std::size_t D, const std::size_t K, typename T, typename Platform>
+void WCMA<N, D, K, T, Platform>::calculateAdaptiveSlices()
+{
+#ifdef DEBUG
+	DriverInterface::debug.printLine( "Entered: calculateAdaptiveSlices", true );
+#endif
+
+	energy_current_slot = from_float<T>( platform.getLuminance() );
+	current_day_samples.push( energy_current_slot );  // stored at `day_index`
+	energy_prediction_matrix( matrix_head, day_index ) = energy_current_slot;
+	sample_energy_quotient = pastDaysQuotient();
+	const T next_pred      = nextPrediction();
+
+	const T storageCycle = numeric_cast<T>( energyPerStorageCycle );
+
+	adaptive_slices = NumericPolicy<T>::ceil( ( last_24h_avg() - storageCycle ) / storageCycle + 1 );
+
+	if ( adaptive_slices < 1 )
+		adaptive_slices = 1;
+
+	sleepTime = minDutyCycle / adaptive_slices;
+
+#ifdef DEBUG
+	DriverInterface::debug.printLine( "energy_prediction_matrix: ", true );
+
+	/* debug */
+	for ( std::size_t i = D; i; --i )
+	{
+		for ( std::size_t j = 0; j < N; ++j )
+			DriverInterface::debug.printFloat( to_float( past_day( i )[j] ), 5, false ),
+			DriverInterface::debug.printLine( " ", false );
+		DriverInterface::debug.printLine( " ", true );
+	}
+
+	/* debug */
+	for ( unsigned int i = 0; i < day_index; ++i )
+		DriverInterface::debug.printLine( "       ", false );
+	DriverInterface::debug.printLine( ".^. current day index", true );
+
+	/* debug */
+	DriverInterface::debug.printLine( "current_day_samples: ", true );
+	for ( std::size_t i = 0; i < N; ++i )
+		DriverInterface::debug.printFloat( to_float( current_day_samples[i] ), 5, false ),
+		DriverInterface::debug.printLine( " ", false );
+	DriverInterface::debug.printLine( "\n", true );
+
+	/* debug */
+	DriverInterface::debug.printLine( "time_distance_weight: ", true );
+	for ( std::size_t i = 0; i < K; ++i )
+		DriverInterface::debug.printFloat( to_float( time_distance_weight[i] ), 3, false ),
+		DriverInterface::debug.printLine( " ", false );
+	DriverInterface::debug.printLine( "\n", true );
+
+	/* debug */
+	DriverInterface::debug.printLine( "sample_energy_quotient: ", true );
+	for ( std::size_t i = 0; i < K; ++i )
+		DriverInterface::debug.printFloat( to_float( sample_energy_quotient[i] ), 3, false ),
+		DriverInterface::debug.printLine( " ", false );
+	DriverInterface::debug.printLine( "\n", true );
+#endif
+
+#ifdef DEBUG
+	DriverInterface::debug.printLine( "energy_current_slot: ", false );
+	DriverInterface::debug.printFloat( to_float( energy_current_slot ), 5, true ),
+
+	DriverInterface::debug.printLine( "mean of past days: ", false );
+	DriverInterface::debug.printFloat( to_float( meanPastDays( day_index ) ), 5, true ),
+
+	DriverInterface::debug.printLine( "last_24h_avg: ", false );
+	DriverInterface::debug.printFloat( to_float( last_24h_avg() ), 5, true );
+
+	DriverInterface::debug.printLine( "Next predicted value: ", false );
+	DriverInterface::debug.printFloat( to_float( next_pred ), 5, true );
+
+	DriverInterface::debug.printLine( "adaptive_slices: ", false );
+	DriverInterface::debug.printFloat( adaptive_slices, 8, true );
+#else
+	( void ) next_pred;
+#endif
+
+	if ( day_index == N - 1 )
+		reorder_prediction_matrix(),
+		day_index = 0;
+	else
+		++day_index;
+}
+
+
+template <const std::size_t N, const std::size_t D, const std::size_t K, typename T, typename Platform>
+void WCMA<N, D, K, T, Platform>::setDutyCycle()
+{
+	platform.sleep( sleepTime );
+}
+
+
+template <const std::size_t N, const std::size_t D, const std::size_t K, typename T, typename Platform>
+T WCMA<N, D, K, T, Platform>::last_24h_avg() const
+{
+	/**
+	 * The `current_day_samples` array is a ring buffer, the values of the
+	 * previous day are only overwritten by the current day's samples, thence
+	 * it always holds the last 24 hours and it can simply be averaged. The
+	 * array keeps a running sum, so this is @f$ O(1) @f$.
+	 *
+	 * Until the first day is complete only the slots measured so far are
+	 * averaged.
+	 */
+	return current_day_samples.average_valid();
+}
+
+
+template <const std::size_t N, const std::size_t D, const std::size_t K, typename T, typename Platform>
+void WCMA<N, D, K, T, Platform>::reorder_prediction_matrix()
+{
+	const T* today   = energy_prediction_matrix.row( matrix_head );
+	const T* evicted = past_day( D );
+
+	for ( std::size_t j = 0; j < N; ++j )
+		column_sum[j] += today[j] - evicted[j];
+
+	// the evicted row receives the samples of the new day
+	matrix_head = matrix_head ? matrix_head - 1 : D;
+
+	if ( !std::numeric_limits<T>::is_exact && ++days_since_resync >= D )
+		resync_column_sum();
+}
+
+
+template <const std::size_t N, const std::size_t D, const std::size_t K, typename T, typename Platform>
+float WCMA<N, D, K, T, Platform>::do_all_the_magic()
+{
+	if ( current_slice == static_cast<unsigned int>( adaptive_slices - 1 ) )
+	{
+		calculateAdaptiveSlices();
+		setDutyCycle();
+		current_slice = 0;
+
+		return to_float( energy_current_slot );
+	}
+	else
+	{
+#ifdef DEBUG
+		DriverInterface::debug.printLine( "current_slice: ", false );
+		DriverInterface::debug.printFloat( current_slice, 3, true );
+#endif
+
+		++current_slice;
+		setDutyCycle();
+
+		return platform.getLuminance();
+	}
+}
+
 #endif /* end of include guard: WCMA_H_0INEYXJP */
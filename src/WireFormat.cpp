@@ -0,0 +1,206 @@
+/*
+ * WireFormat.cpp
+ *
+ *  Created on: 2026-10-17
+ *      Author: agent
+ */
+
+#include "WireFormat.h"
+
+namespace
+{
+	uint8_t put16( const uint16_t v, uint8_t *out )
+	{
+		out[0] = static_cast<uint8_t>( v );
+		out[1] = static_cast<uint8_t>( v >> 8 );
+		return 2;
+	}
+
+	uint8_t put32( const uint32_t v, uint8_t *out )
+	{
+		put16( static_cast<uint16_t>( v ), out );
+		put16( static_cast<uint16_t>( v >> 16 ), out + 2 );
+		return 4;
+	}
+
+	uint16_t get16( const uint8_t *in )
+	{
+		return static_cast<uint16_t>( in[0] | in[1] << 8 );
+	}
+
+	uint32_t get32( const uint8_t *in )
+	{
+		return get16( in ) | static_cast<uint32_t>( get16( in + 2 ) ) << 16;
+	}
+
+	uint8_t encodeHeader( const WireFormat::Type type, const uint8_t fields, const uint8_t nodeID,
+		uint8_t *out )
+	{
+		out[0] = static_cast<uint8_t>( WireFormat::version << 6 | type << 4 | ( fields & 0x0f ) );
+		out[1] = nodeID;
+		return WireFormat::headerSize;
+	}
+
+	/**
+	 * Bytes of a reading with the given fields.
+	 */
+	uint8_t readingSize( const uint8_t fields )
+	{
+		return ( fields & WireFormat::climate ? 4 : 0 ) + ( fields & WireFormat::slices ? 2 : 0 )
+			+ ( fields & WireFormat::sleep ? 2 : 0 ) + ( fields & WireFormat::battery ? 2 : 0 );
+	}
+}
+
+
+bool WireFormat::decodeHeader( const uint8_t *in, const uint8_t size, Header& header )
+{
+	if ( size < headerSize )
+		return false;
+
+	header.version = in[0] >> 6;
+	header.type    = static_cast<Type>( in[0] >> 4 & 0x03 );
+	header.fields  = in[0] & 0x0f;
+	header.node_id = in[1];
+
+	return header.version == version;
+}
+
+
+uint8_t WireFormat::encodeReading( const uint8_t nodeID, const uint8_t fields,
+	const UplinkBatch::Reading& reading, uint8_t *out )
+{
+	uint8_t n = encodeHeader( WireFormat::reading, fields, nodeID, out );
+
+	if ( fields & climate )
+	{
+		n += put16( static_cast<uint16_t>( reading.temperature ), out + n );
+		n += put16( reading.humidity, out + n );
+	}
+
+	if ( fields & slices )
+		n += put16( reading.adaptive_slices, out + n );
+
+	if ( fields & sleep )
+		n += put16( reading.sleep_time, out + n );
+
+	if ( fields & battery )
+		n += put16( reading.battery_level, out + n );
+
+	return n;
+}
+
+
+bool WireFormat::decodeReading( const uint8_t *in, const uint8_t size, UplinkBatch::Reading& reading )
+{
+	Header header;
+
+	if ( !decodeHeader( in, size, header ) || size < headerSize + readingSize( header.fields ) )
+		return false;
+
+	const uint8_t *p = in + headerSize;
+
+	reading.temperature     = 0;
+	reading.humidity        = 0;
+	reading.adaptive_slices = 0;
+	reading.sleep_time      = 0;
+	reading.battery_level   = 0;
+
+	if ( header.fields & climate )
+	{
+		reading.temperature = static_cast<int16_t>( get16( p ) );
+		reading.humidity    = get16( p + 2 );
+		p += 4;
+	}
+
+	if ( header.fields & slices )
+	{
+		reading.adaptive_slices = get16( p );
+		p += 2;
+	}
+
+	if ( header.fields & sleep )
+	{
+		reading.sleep_time = get16( p );
+		p += 2;
+	}
+
+	if ( header.fields & battery )
+		reading.battery_level = get16( p );
+
+	return true;
+}
+
+
+uint8_t WireFormat::encodeBatch( const uint8_t nodeID, const UplinkBatch& readings, uint8_t *out,
+	uint8_t& count )
+{
+	uint8_t bytes;
+
+	encodeHeader( batch, allFields, nodeID, out );
+
+	count           = readings.encode( out + headerSize + 1, maxFrameSize - headerSize - 1, bytes );
+	out[headerSize] = count;
+
+	return headerSize + 1 + bytes;
+}
+
+
+uint8_t WireFormat::decodeBatch( const uint8_t *in, const uint8_t size, UplinkBatch::Reading *out )
+{
+	if ( size < headerSize + 1 )
+		return 0;
+
+	const uint8_t count = in[headerSize] < UplinkBatch::capacity ? in[headerSize] : UplinkBatch::capacity;
+
+	return UplinkBatch::decode( in + headerSize + 1, size - headerSize - 1, count, out );
+}
+
+
+uint8_t WireFormat::encodeEnergyLog( const uint8_t nodeID, const EnergyLog& log, const uint8_t first,
+	uint8_t *out, uint8_t& count )
+{
+	uint8_t n = encodeHeader( energyLog, 0, nodeID, out ) + 1;
+
+	for ( count = 0; first + count < log.count() && n + recordSize <= maxFrameSize; ++count )
+	{
+		const EnergyLog::Record& record = log[first + count];
+
+		for ( uint8_t p = 0; p < EnergyLog::phases; ++p )
+			n += put32( record.time[p], out + n );
+
+		for ( uint8_t p = 0; p < EnergyLog::phases; ++p )
+			n += put16( record.energy[p], out + n );
+
+		n += put16( record.sequence, out + n );
+	}
+
+	out[headerSize] = count;
+
+	return n;
+}
+
+
+uint8_t WireFormat::decodeEnergyLog( const uint8_t *in, const uint8_t size, EnergyLog::Record *out )
+{
+	if ( size < headerSize + 1 )
+		return 0;
+
+	const uint8_t *p     = in + headerSize + 1;
+	uint8_t        count = 0;
+
+	for ( ; count < in[headerSize] && count < maxFrameSize / recordSize && p + recordSize <= in + size; ++count )
+	{
+		EnergyLog::Record& record = out[count];
+
+		for ( uint8_t i = 0; i < EnergyLog::phases; ++i, p += 4 )
+			record.time[i] = get32( p );
+
+		for ( uint8_t i = 0; i < EnergyLog::phases; ++i, p += 2 )
+			record.energy[i] = get16( p );
+
+		record.sequence = get16( p );
+		p += 2;
+	}
+
+	return count;
+}
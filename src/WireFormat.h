@@ -0,0 +1,146 @@
+/*
+ * WireFormat.h
+ *
+ *  Created on: 2026-10-17
+ *      Author: agent
+ */
+
+#ifndef WIREFORMAT_H_C6PX3NJU
+#define WIREFORMAT_H_C6PX3NJU
+
+#include <stdint.h>
+#include "UplinkBatch.h"
+#include "EnergyLog.h"
+
+/**
+ * Format of the frames sent from the sensor nodes to the controller.
+ *
+ * Shared by the firmware, the controller and the host tools. A frame starts
+ * with two bytes:
+ *
+ * | bits 7-6 | bits 5-4 | bits 3-0 |         |
+ * |----------|----------|----------|---------|
+ * | version  | type     | fields   | node id |
+ *
+ * `fields` has a bit for each group of fields present, see `Field`. The
+ * body depends on the type:
+ *
+ * - `reading`: the present fields of one reading in the order of `Field`,
+ *   each as a 16 bit number.
+ * - `batch`: the number of readings in one byte, followed by the readings
+ *   encoded by `UplinkBatch`. All fields are present. The readings carry no
+ *   time, a reading was taken the sum of its own sleep time and those of
+ *   the later readings, except the newest, before the newest reading of
+ *   the frame, see `UplinkBatch::age()`. The newest reading of the last
+ *   frame of a batch is taken right before the frames are sent, the frames
+ *   of a batch are sent back to back.
+ * - `energyLog`: the number of records in one byte, followed by the
+ *   records of the `EnergyLog`. Each record is the time of the phases, 32
+ *   bit each, their energy, 16 bit each, and the sequence number, 16 bit.
+ *
+ * All numbers are little-endian, the units are those of
+ * `UplinkBatch::Reading` and `EnergyLog::Record`. The encoders write byte by
+ * byte, so the format neither depends on the byte order nor on the padding
+ * of the compiler.
+ */
+namespace WireFormat
+{
+	const uint8_t version      = 1;
+	const uint8_t headerSize   = 2;
+	const uint8_t maxFrameSize = 60;  ///< size of the radio payload
+
+	enum Type
+	{
+		reading   = 0,
+		batch     = 1,
+		energyLog = 2
+	};
+
+	enum Field
+	{
+		climate   = 1 << 0,  ///< temperature and humidity
+		slices    = 1 << 1,  ///< adaptive slices
+		sleep     = 1 << 2,  ///< sleep time
+		battery   = 1 << 3,  ///< battery level
+		allFields = climate | slices | sleep | battery
+	};
+
+	struct Header
+	{
+		uint8_t version;
+		Type    type;
+		uint8_t fields;
+		uint8_t node_id;
+	};
+
+	/**
+	 * Bytes of an energy log record.
+	 */
+	const uint8_t recordSize = EnergyLog::phases * 6 + 2;
+
+	/**
+	 * Reads the header of a frame.
+	 *
+	 * @return `false` if the frame is too short or of another version.
+	 */
+	bool decodeHeader( const uint8_t *in, const uint8_t size, Header& header );
+
+	/**
+	 * Writes a frame with one reading.
+	 *
+	 * @param out Destination, `maxFrameSize` bytes.
+	 *
+	 * @return Size of the frame.
+	 */
+	uint8_t encodeReading( const uint8_t nodeID, const uint8_t fields,
+		const UplinkBatch::Reading& reading, uint8_t *out );
+
+	/**
+	 * Reads a frame with one reading. Fields not present are zero.
+	 *
+	 * @return `false` if the frame is too short.
+	 */
+	bool decodeReading( const uint8_t *in, const uint8_t size, UplinkBatch::Reading& reading );
+
+	/**
+	 * Writes a frame with the oldest readings of a batch.
+	 *
+	 * @param out   Destination, `maxFrameSize` bytes.
+	 * @param count Readings written, as many as fit.
+	 *
+	 * @return Size of the frame.
+	 */
+	uint8_t encodeBatch( const uint8_t nodeID, const UplinkBatch& batch, uint8_t *out, uint8_t& count );
+
+	/**
+	 * Reads a frame with several readings.
+	 *
+	 * @param out Destination, `UplinkBatch::capacity` readings.
+	 *
+	 * @return Readings read.
+	 */
+	uint8_t decodeBatch( const uint8_t *in, const uint8_t size, UplinkBatch::Reading *out );
+
+	/**
+	 * Writes a frame with records of an energy log.
+	 *
+	 * @param first Index of the first record written.
+	 * @param out   Destination, `maxFrameSize` bytes.
+	 * @param count Records written, as many as fit.
+	 *
+	 * @return Size of the frame.
+	 */
+	uint8_t encodeEnergyLog( const uint8_t nodeID, const EnergyLog& log, const uint8_t first,
+		uint8_t *out, uint8_t& count );
+
+	/**
+	 * Reads a frame with records of an energy log.
+	 *
+	 * @param out Destination, `maxFrameSize / recordSize` records.
+	 *
+	 * @return Records read.
+	 */
+	uint8_t decodeEnergyLog( const uint8_t *in, const uint8_t size, EnergyLog::Record *out );
+}
+
+#endif /* end of include guard: WIREFORMAT_H_C6PX3NJU */
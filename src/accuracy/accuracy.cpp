@@ -0,0 +1,197 @@
+/*
+ * accuracy.cpp
+ *
+ * Compares the fixed-point instantiations of the EWMA and WCMA predictors
+ * with the float version. The predictors are the unmodified firmware code on
+ * the platform of the simulator. The luminance trace is either read from a
+ * file, one value per slot and line, or generated synthetically.
+ *
+ *  Created on: 2026-10-17
+ *      Author: agent
+ */
+
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+#include "EWMA.h"
+#include "WCMA.h"
+#include "Simulation.h"
+
+const std::size_t slots = Configuration::slotsPerDay;
+
+// the results of one slot that are compared
+enum Output { ewma_pred, ewma_slices, wcma_md, wcma_gap, wcma_pred, wcma_24h, wcma_slices, outputs };
+
+const char *output_names[outputs] = {
+	"EWMA prediction",
+	"EWMA adaptive slices",
+	"WCMA M_D",
+	"WCMA GAP",
+	"WCMA prediction",
+	"WCMA last 24h average",
+	"WCMA adaptive slices",
+};
+
+typedef std::vector< std::vector<float> > results_t;
+
+
+/**
+ * Runs the EWMA and WCMA predictors of the firmware over the trace with
+ * number type T.
+ *
+ * Both are stepped once per slot, so every number type sees the same
+ * samples no matter how many slices it would sleep.
+ */
+template <typename T>
+results_t run( const Trace& trace )
+{
+	Simulation::Parameters parameters;
+	parameters.slotLength      = trace.period();
+	parameters.capacitance     = 1;
+	parameters.maxVoltage      = to_float( Configuration::energyStorageFull );
+	parameters.emptyVoltage    = to_float( Configuration::energyStorageEmpty );
+	parameters.initialVoltage  = parameters.maxVoltage;
+	parameters.energyPerWakeup = 0;
+
+	Simulation simulation( trace, parameters );
+
+	EWMA<slots, T, SimulatedPlatform> ewma( ( SimulatedPlatform( &simulation ) ) );
+	WCMA<slots, Configuration::retainDays, Configuration::retainSamples, T, SimulatedPlatform>
+		wcma( ( SimulatedPlatform( &simulation ) ) );
+
+	ewma.initialize();
+	wcma.initialize();
+
+	results_t r( outputs, std::vector<float>( trace.size() ) );
+
+	for ( std::size_t s = 0; s < trace.size(); ++s )
+	{
+		ewma.calculateAdaptiveSlices();
+		wcma.calculateAdaptiveSlices();
+
+		r[ewma_pred][s]   = to_float( ewma.nextPrediction() );
+		r[ewma_slices][s] = ewma.adaptive_slices;
+
+		// the predictors have moved on to the next slot
+		r[wcma_md][s]     = to_float( wcma.meanPastDays( ( s + 1 ) % slots ) );
+		r[wcma_gap][s]    = to_float( wcma.gap() );
+		r[wcma_pred][s]   = to_float( wcma.nextPrediction() );
+		r[wcma_24h][s]    = to_float( wcma.last_24h_avg() );
+		r[wcma_slices][s] = wcma.adaptive_slices;
+
+		simulation.sleep( trace.period() );
+	}
+
+	return r;
+}
+
+
+template <typename T>
+void report( const char *name, const results_t& reference, const Trace& trace )
+{
+	const results_t r = run<T>( trace );
+
+	std::cout << name << std::endl;
+
+	for ( unsigned int o = 0; o < outputs; ++o )
+	{
+		double      max_abs = 0, sum_abs = 0, max_rel = 0;
+		double      min_fixed = 0, max_fixed = 0;
+		std::size_t compared = 0, non_finite = 0;
+
+		for ( std::size_t s = 0; s < trace.size(); ++s )
+		{
+			const double ref = reference[o][s];
+			const double err = std::fabs( r[o][s] - ref );
+
+			// divisions by zero, e.g. quotients at night, saturate in
+			// fixed-point, their results are reported separately
+			if ( !std::isfinite( ref ) )
+			{
+				const double fixed = r[o][s];
+
+				min_fixed = non_finite ? std::min( min_fixed, fixed ) : fixed;
+				max_fixed = non_finite ? std::max( max_fixed, fixed ) : fixed;
+				++non_finite;
+				continue;
+			}
+
+			max_abs  = std::max( max_abs, err );
+			sum_abs += err;
+			++compared;
+
+			if ( std::fabs( ref ) > 1e-3 )
+				max_rel = std::max( max_rel, err / std::fabs( ref ) );
+		}
+
+		std::cout
+			<< "  " << std::left << std::setw( 24 ) << output_names[o] << std::right
+			<< "  max abs " << std::setw( 12 ) << max_abs
+			<< "  mean abs " << std::setw( 12 ) << ( compared ? sum_abs / compared : 0 )
+			<< "  max rel " << std::setw( 12 ) << max_rel << std::endl;
+
+		if ( non_finite )
+			std::cout << "  " << std::setw( 24 ) << "" << "  " << non_finite
+				<< " slots non-finite in float reference, fixed result was "
+				<< min_fixed << " to " << max_fixed << std::endl;
+	}
+
+	std::cout << std::endl;
+}
+
+
+int main( int argc, char *argv[] )
+{
+	std::size_t n_days = 30;
+	float       peak   = 2;
+	int         opt;
+
+	while ( ( opt = getopt( argc, argv, "d:p:" ) ) != -1 )
+		switch ( opt )
+		{
+		case 'd':
+			n_days = std::atoi( optarg );
+			break;
+
+		case 'p':
+			peak = std::atof( optarg );
+			break;
+
+		default:
+			std::cerr << "usage: " << argv[0] << " [-d days] [-p peak] [trace]" << std::endl;
+			return EXIT_FAILURE;
+		}
+
+	Trace trace( Configuration::secondsPerDay / slots );
+
+	if ( optind < argc )
+	{
+		if ( !trace.load_csv( argv[optind] ) )
+		{
+			std::cerr << "can not open " << argv[optind] << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+	else
+		trace.synthetic( n_days, peak );
+
+	if ( trace.empty() )
+	{
+		std::cerr << "empty trace" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::cout << "Accuracy against float over " << trace.size() << " slots" << std::endl << std::endl;
+
+	const results_t reference = run<float>( trace );
+
+	report<q16_16_t>( "Q16.16", reference, trace );
+	report<q8_24_t> ( "Q8.24",  reference, trace );
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,215 @@
+/*
+ * Counted.h
+ *
+ *  Created on: 2026-10-17
+ *      Author: agent
+ */
+
+#ifndef COUNTED_H_R9LW4PJT
+#define COUNTED_H_R9LW4PJT
+
+#include <limits>
+#include "Numeric.h"
+
+/**
+ * Number of arithmetic operations by kind.
+ */
+struct OpCounts
+{
+	double add;   ///< additions and subtractions
+	double mul;   ///< multiplications
+	double div;   ///< divisions
+	double cmp;   ///< comparisons
+	double conv;  ///< conversions from and to `float` or `int`
+
+	void clear()
+	{
+		add = mul = div = cmp = conv = 0;
+	}
+};
+
+/**
+ * The operations counted since the last `clear()`.
+ */
+inline OpCounts& op_counts()
+{
+	static OpCounts counts = OpCounts();
+	return counts;
+}
+
+
+/**
+ * A number type that counts its arithmetic operations.
+ *
+ * Behaves like @f$ T @f$ and records every operation in `op_counts()`, so
+ * the algorithms can be instantiated with it to obtain their instruction
+ * mix.
+ *
+ * @param The number type that does the actual computation.
+ */
+template <typename T> class Counted
+{
+	T value;
+
+public:
+
+	Counted() : value( 0 ) {}
+
+	Counted( const int i ) : value( i ) {}
+
+	explicit Counted( const float f ) : value( NumericPolicy<T>::from_float( f ) )
+	{
+		++op_counts().conv;
+	}
+
+	explicit Counted( const double d ) : value( NumericPolicy<T>::from_float( d ) )
+	{
+		++op_counts().conv;
+	}
+
+	/**
+	 * Wraps a value without counting an operation.
+	 */
+	static Counted wrap( const T& t )
+	{
+		Counted c;
+		c.value = t;
+		return c;
+	}
+
+	const T& get() const
+	{
+		return value;
+	}
+
+	Counted& operator+=( const Counted& o ) { ++op_counts().add; value += o.value; return *this; }
+	Counted& operator-=( const Counted& o ) { ++op_counts().add; value -= o.value; return *this; }
+	Counted& operator*=( const Counted& o ) { ++op_counts().mul; value *= o.value; return *this; }
+	Counted& operator/=( const Counted& o ) { ++op_counts().div; value /= o.value; return *this; }
+	Counted& operator*=( const int i )      { ++op_counts().mul; value *= i;       return *this; }
+	Counted& operator/=( const int i )      { ++op_counts().div; value /= i;       return *this; }
+
+	Counted operator-() const
+	{
+		++op_counts().add;
+		return wrap( -value );
+	}
+
+	friend Counted operator+( Counted a, const Counted& b ) { return a += b; }
+	friend Counted operator-( Counted a, const Counted& b ) { return a -= b; }
+	friend Counted operator*( Counted a, const Counted& b ) { return a *= b; }
+	friend Counted operator*( Counted a, const int b )      { return a *= b; }
+	friend Counted operator/( Counted a, const Counted& b ) { return a /= b; }
+	friend Counted operator/( Counted a, const int b )      { return a /= b; }
+
+	friend bool operator==( const Counted& a, const Counted& b ) { ++op_counts().cmp; return !( a.value < b.value ) && !( b.value < a.value ); }
+	friend bool operator!=( const Counted& a, const Counted& b ) { return !( a == b ); }
+	friend bool operator< ( const Counted& a, const Counted& b ) { ++op_counts().cmp; return a.value <  b.value; }
+	friend bool operator> ( const Counted& a, const Counted& b ) { ++op_counts().cmp; return a.value >  b.value; }
+	friend bool operator<=( const Counted& a, const Counted& b ) { ++op_counts().cmp; return a.value <= b.value; }
+	friend bool operator>=( const Counted& a, const Counted& b ) { ++op_counts().cmp; return a.value >= b.value; }
+};
+
+
+/**
+ * Arithmetic building blocks of the counting type.
+ *
+ * Delegates to the policy of @f$ T @f$ and counts the operations.
+ */
+template <typename T> struct NumericPolicy< Counted<T> >
+{
+	static Counted<T> mac( const Counted<T>& acc, const Counted<T>& a, const Counted<T>& b )
+	{
+		++op_counts().mul;
+		++op_counts().add;
+		return Counted<T>::wrap( NumericPolicy<T>::mac( acc.get(), a.get(), b.get() ) );
+	}
+
+	/**
+	 * Folded into a constant, so nothing is counted.
+	 */
+	template <const unsigned int n> static Counted<T> reciprocal()
+	{
+		return Counted<T>::wrap( NumericPolicy<T>::template reciprocal<n>() );
+	}
+
+	static int ceil( const Counted<T>& t )
+	{
+		++op_counts().conv;
+		return NumericPolicy<T>::ceil( t.get() );
+	}
+
+	static Counted<T> from_float( const float f )
+	{
+		++op_counts().conv;
+		return Counted<T>::wrap( NumericPolicy<T>::from_float( f ) );
+	}
+
+	static float to_float( const Counted<T>& t )
+	{
+		++op_counts().conv;
+		return NumericPolicy<T>::to_float( t.get() );
+	}
+};
+
+
+/**
+ * Reading a configuration value of the underlying type is free.
+ */
+template <typename T> struct NumericCast< Counted<T>, T >
+{
+	static Counted<T> convert( const T& t )
+	{
+		return Counted<T>::wrap( t );
+	}
+};
+
+
+namespace std
+{
+	template <typename T> class numeric_limits< Counted<T> >
+	{
+	public:
+		static const bool is_specialized = true;
+		static const bool is_signed      = numeric_limits<T>::is_signed;
+		static const bool is_integer     = numeric_limits<T>::is_integer;
+		static const bool is_exact       = numeric_limits<T>::is_exact;
+
+		static Counted<T> max()    { return Counted<T>::wrap( numeric_limits<T>::max() ); }
+		static Counted<T> lowest() { return Counted<T>::wrap( numeric_limits<T>::lowest() ); }
+	};
+}
+
+
+/**
+ * Estimated cost of the operations on a Cortex-M3 in cycles.
+ *
+ * The Cortex-M3 has no FPU, `float` operations are calls into the soft-float
+ * routines of libgcc. Fixed-point numbers widen to 64 bit for the
+ * saturation, a division is a call to `__aeabi_ldivmod`. The figures are
+ * rough averages, the actual cost depends on the operands.
+ */
+template <typename T> struct CortexM3
+{
+	static const unsigned int add  = 60;
+	static const unsigned int mul  = 55;
+	static const unsigned int div  = 180;
+	static const unsigned int cmp  = 30;
+	static const unsigned int conv = 40;
+};
+
+template <const unsigned int F> struct CortexM3< Fixed<F> >
+{
+	static const unsigned int add  = 5;
+	static const unsigned int mul  = 8;
+	static const unsigned int div  = 110;
+	static const unsigned int cmp  = 1;
+	static const unsigned int conv = 60;
+};
+
+/**
+ * Cycles of one load or store of 32 bit.
+ */
+const unsigned int cortexM3MemoryCycles = 2;
+
+#endif /* end of include guard: COUNTED_H_R9LW4PJT */
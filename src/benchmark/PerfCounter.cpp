@@ -0,0 +1,63 @@
+/*
+ * PerfCounter.cpp
+ *
+ *  Created on: 2026-10-17
+ *      Author: agent
+ */
+
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "PerfCounter.h"
+
+
+PerfCounter::PerfCounter()
+{
+	perf_event_attr attr;
+	std::memset( &attr, 0, sizeof( attr ) );
+
+	attr.type           = PERF_TYPE_HARDWARE;
+	attr.size           = sizeof( attr );
+	attr.config         = PERF_COUNT_HW_INSTRUCTIONS;
+	attr.disabled       = 1;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv     = 1;
+
+	fd = syscall( __NR_perf_event_open, &attr, 0, -1, -1, 0 );
+}
+
+
+PerfCounter::~PerfCounter()
+{
+	if ( available() )
+		close( fd );
+}
+
+
+void PerfCounter::start()
+{
+	if ( !available() )
+		return;
+
+	ioctl( fd, PERF_EVENT_IOC_RESET, 0 );
+	ioctl( fd, PERF_EVENT_IOC_ENABLE, 0 );
+}
+
+
+uint64_t PerfCounter::stop()
+{
+	if ( !available() )
+		return 0;
+
+	ioctl( fd, PERF_EVENT_IOC_DISABLE, 0 );
+
+	uint64_t count = 0;
+
+	if ( read( fd, &count, sizeof( count ) ) != sizeof( count ) )
+		return 0;
+
+	return count;
+}
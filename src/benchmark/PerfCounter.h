@@ -0,0 +1,47 @@
+/*
+ * PerfCounter.h
+ *
+ *  Created on: 2026-10-17
+ *      Author: agent
+ */
+
+#ifndef PERFCOUNTER_H_V3KS8DQM
+#define PERFCOUNTER_H_V3KS8DQM
+
+#include <stdint.h>
+
+/**
+ * Counts the instructions retired by this thread in user space.
+ *
+ * Uses the performance counters of Linux. If they are not accessible, e.g.
+ * because of `kernel.perf_event_paranoid` or in a container, the counter is
+ * not available and reads zero.
+ */
+class PerfCounter
+{
+	int fd;
+
+public:
+
+	PerfCounter();
+	~PerfCounter();
+
+	bool available() const
+	{
+		return fd >= 0;
+	}
+
+	void start();
+
+	/**
+	 * @return Instructions since `start()`.
+	 */
+	uint64_t stop();
+
+private:
+
+	PerfCounter( const PerfCounter& );
+	PerfCounter& operator=( const PerfCounter& );
+};
+
+#endif /* end of include guard: PERFCOUNTER_H_V3KS8DQM */
@@ -0,0 +1,390 @@
+/*
+ * benchmark.cpp
+ *
+ * Microbenchmarks of the hot paths of the predictors for several values of
+ * `slotsPerDay`, `retainDays` and `retainSamples`.
+ *
+ * By default the time and the instructions per operation are measured on
+ * the host. With `-m` the algorithms are instantiated with a counting number
+ * type instead, and the cycles on a Cortex-M3 are estimated from the
+ * operations counted. The bytes touched per operation are not measured but
+ * estimated from the access pattern of the operation and the size of the
+ * number type, hence the column is labelled "est B/op".
+ *
+ *  Created on: 2026-10-17
+ *      Author: agent
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+
+#include "Array.h"
+#include "HistoricalAverage.h"
+#include "EWMA.h"
+#include "WCMA.h"
+#include "Counted.h"
+#include "PerfCounter.h"
+
+
+/**
+ * Keeps the compiler from optimising a result away.
+ */
+template <typename T> inline void escape( const T& t )
+{
+	asm volatile( "" : : "r"( &t ) : "memory" );
+}
+
+
+/**
+ * Platform with a pseudo-random luminance, which never sleeps.
+ */
+class BenchPlatform
+{
+	uint32_t state;
+
+public:
+
+	BenchPlatform() : state( 1 ) {}
+
+	float getLuminance()
+	{
+		state = state * 1664525u + 1013904223u;
+		return ( state >> 8 ) * ( 2.f / ( 1 << 24 ) );
+	}
+
+	float getStorageVoltage() { return 2; }
+	void  resetClock()        {}
+	void  sleep( unsigned int ) {}
+};
+
+
+/**
+ * Runs the benchmarks and prints one row per benchmark.
+ */
+class Suite
+{
+public:
+
+	/**
+	 * Cost of the operations in Cortex-M3 cycles.
+	 */
+	struct Costs
+	{
+		unsigned int add, mul, div, cmp, conv;
+	};
+
+	Suite( const bool c, const Costs& m3, const std::string& f ) :
+		counting( c ), costs( m3 ), filter( f ) {}
+
+	void header() const;
+
+	/**
+	 * Measures one operation.
+	 *
+	 * @param name  Name of the benchmark.
+	 * @param bytes Estimated bytes read and written by one operation, from
+	 *              its access pattern and `sizeof` the number type.
+	 * @param op    The operation.
+	 */
+	template <typename F>
+	void run( const char *name, const std::size_t N, const std::size_t D, const std::size_t K,
+		const double bytes, F op );
+
+private:
+
+	const bool        counting;
+	const Costs       costs;
+	const std::string filter;
+	PerfCounter       instructions;
+
+	void row( const char *name, const std::size_t N, const std::size_t D, const std::size_t K ) const;
+};
+
+
+void Suite::header() const
+{
+	std::cout << std::left << std::setw( 36 ) << "benchmark" << std::right
+		<< std::setw( 5 ) << "N" << std::setw( 4 ) << "D" << std::setw( 4 ) << "K";
+
+	if ( counting )
+		std::cout
+			<< std::setw( 8 ) << "add" << std::setw( 8 ) << "mul" << std::setw( 8 ) << "div"
+			<< std::setw( 8 ) << "cmp" << std::setw( 8 ) << "conv"
+			<< std::setw( 10 ) << "est B/op" << std::setw( 12 ) << "M3 cycles";
+	else
+		std::cout
+			<< std::setw( 12 ) << "ns/op" << std::setw( 12 ) << "instr/op"
+			<< std::setw( 10 ) << "est B/op";
+
+	std::cout << std::endl;
+}
+
+
+void Suite::row( const char *name, const std::size_t N, const std::size_t D, const std::size_t K ) const
+{
+	std::cout << std::left << std::setw( 36 ) << name << std::right
+		<< std::setw( 5 ) << N << std::setw( 4 ) << D << std::setw( 4 ) << K;
+}
+
+
+template <typename F>
+void Suite::run( const char *name, const std::size_t N, const std::size_t D, const std::size_t K,
+	const double bytes, F op )
+{
+	if ( std::string( name ).find( filter ) == std::string::npos )
+		return;
+
+	row( name, N, D, K );
+	std::cout << std::fixed << std::setprecision( 1 );
+
+	if ( counting )
+	{
+		// averaged over many calls, some operations vary between calls
+		const unsigned int calls = 1000;
+
+		op_counts().clear();
+
+		for ( unsigned int i = 0; i < calls; ++i )
+			op();
+
+		const OpCounts& c = op_counts();
+		const double cycles = ( c.add * costs.add + c.mul * costs.mul + c.div * costs.div
+			+ c.cmp * costs.cmp + c.conv * costs.conv ) / calls + bytes / 4 * cortexM3MemoryCycles;
+
+		std::cout
+			<< std::setw( 8 ) << c.add / calls << std::setw( 8 ) << c.mul / calls
+			<< std::setw( 8 ) << c.div / calls << std::setw( 8 ) << c.cmp / calls
+			<< std::setw( 8 ) << c.conv / calls
+			<< std::setw( 10 ) << bytes << std::setw( 12 ) << cycles;
+	}
+	else
+	{
+		// double the iterations until the run takes long enough to be timed
+		unsigned long iterations = 1;
+		double        elapsed;
+
+		for ( ;; iterations *= 2 )
+		{
+			const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+			for ( unsigned long i = 0; i < iterations; ++i )
+				op();
+
+			elapsed = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+
+			if ( elapsed > .02 )
+				break;
+		}
+
+		instructions.start();
+
+		for ( unsigned long i = 0; i < iterations; ++i )
+			op();
+
+		const double instr = static_cast<double>( instructions.stop() ) / iterations;
+
+		std::cout << std::setw( 12 ) << elapsed * 1e9 / iterations;
+
+		if ( instructions.available() )
+			std::cout << std::setw( 12 ) << instr;
+		else
+			std::cout << std::setw( 12 ) << "n/a";
+
+		std::cout << std::setw( 10 ) << bytes;
+	}
+
+	std::cout << std::defaultfloat << std::endl;
+}
+
+
+/**
+ * All benchmarks of one parameter set.
+ */
+template <const std::size_t N, const std::size_t D, const std::size_t K, typename T>
+void benchmarks( Suite& suite )
+{
+	const double size = sizeof( T );
+
+	Array<T, N> values;
+	Array<T, K> a, b;
+	HistoricalAverage<N, T> history;
+	BenchPlatform platform;
+
+	for ( std::size_t i = 0; i < N; ++i )
+		values.push( from_float<T>( platform.getLuminance() ) ),
+		history.push( from_float<T>( platform.getLuminance() ) );
+
+	for ( std::size_t i = 0; i < K; ++i )
+		a[i] = from_float<T>( platform.getLuminance() ),
+		b[i] = from_float<T>( platform.getLuminance() );
+
+	suite.run( "Array::sum", N, D, K, N * size, [&]
+	{
+		escape( values.sum() );
+	} );
+
+	suite.run( "Array::dotproduct", N, D, K, 2 * K * size, [&]
+	{
+		escape( a.dotproduct( b ) );
+	} );
+
+	suite.run( "HistoricalAverage::average", N, D, K, size, [&]
+	{
+		escape( history.average() );
+	} );
+
+	WCMA<N, D, K, T, BenchPlatform> wcma;
+	wcma.initialize();
+
+	// a few days, so the matrix is not uniform
+	for ( std::size_t i = 0; i < 3 * N; ++i )
+		wcma.calculateAdaptiveSlices();
+
+	std::size_t slot = 0;
+
+	suite.run( "WCMA::meanPastDays", N, D, K, size, [&]
+	{
+		escape( wcma.meanPastDays( slot ) );
+		slot = slot + 1 < N ? slot + 1 : 0;
+	} );
+
+	suite.run( "WCMA::pastDaysQuotient", N, D, K, 3 * K * size, [&]
+	{
+		escape( wcma.pastDaysQuotient() );
+	} );
+
+	// read today and the evicted day, update the sums, for inexact types
+	// the sums are recomputed every D days
+	const double reorder = 4 * N * size + ( std::numeric_limits<T>::is_exact ? 0 : ( D + 1 ) * N * size / D );
+
+	suite.run( "WCMA::reorder_prediction_matrix", N, D, K, reorder, [&]
+	{
+		wcma.reorder_prediction_matrix();
+	} );
+
+	EWMA<N, T, BenchPlatform> ewma;
+	ewma.initialize();
+
+	// pop, push and the running sum
+	suite.run( "EWMA::calculateAdaptiveSlices", N, D, K, 4 * size, [&]
+	{
+		ewma.calculateAdaptiveSlices();
+	} );
+}
+
+
+/**
+ * The parameter sets: the defaults and each parameter varied on its own.
+ */
+template <typename T>
+void sweep( Suite& suite )
+{
+	benchmarks< 48,  4,  3, T>( suite );
+
+	benchmarks< 24,  4,  3, T>( suite );
+	benchmarks< 96,  4,  3, T>( suite );
+	benchmarks<288,  4,  3, T>( suite );
+
+	benchmarks< 48,  2,  3, T>( suite );
+	benchmarks< 48,  8,  3, T>( suite );
+	benchmarks< 48, 16,  3, T>( suite );
+
+	benchmarks< 48,  4,  1, T>( suite );
+	benchmarks< 48,  4,  6, T>( suite );
+	benchmarks< 48,  4, 12, T>( suite );
+}
+
+
+template <typename T>
+void run( const bool counting, const std::string& filter )
+{
+	const Suite::Costs costs =
+	{
+		CortexM3<T>::add, CortexM3<T>::mul, CortexM3<T>::div, CortexM3<T>::cmp, CortexM3<T>::conv
+	};
+
+	Suite suite( counting, costs, filter );
+	suite.header();
+
+	Configuration configuration;
+	uint8_t       packet[12] = { 0 };
+
+	suite.run( "Configuration::updateConfiguration", 0, 0, 0, sizeof( packet ), [&]
+	{
+		configuration.updateConfiguration( packet );
+		escape( configuration );
+	} );
+
+	if ( counting )
+		sweep< Counted<T> >( suite );
+	else
+		sweep<T>( suite );
+}
+
+
+void usage( const char *name )
+{
+	std::cerr
+		<< "usage: " << name << " [-q bits] [-m] [-f filter]" << std::endl
+		<< "  -q bits    fractional bits of fixed-point numbers, 0 for float, 16 or 24" << std::endl
+		<< "  -m         estimate Cortex-M3 cycles from the operations" << std::endl
+		<< "  -f filter  only benchmarks whose name contains the filter" << std::endl;
+}
+
+
+int main( int argc, char *argv[] )
+{
+	int         fractionBits = 0;
+	bool        counting     = false;
+	std::string filter;
+	int         opt;
+
+	while ( ( opt = getopt( argc, argv, "q:mf:" ) ) != -1 )
+		switch ( opt )
+		{
+		case 'q':
+			// a typo must not fall back to float
+			fractionBits = std::string( optarg ) == "0" || std::string( optarg ) == "16"
+				|| std::string( optarg ) == "24" ? std::atoi( optarg ) : -1;
+			break;
+
+		case 'm':
+			counting = true;
+			break;
+
+		case 'f':
+			filter = optarg;
+			break;
+
+		default:
+			usage( argv[0] );
+			return EXIT_FAILURE;
+		}
+
+	if ( fractionBits != 0 && fractionBits != 16 && fractionBits != 24 )
+	{
+		usage( argv[0] );
+		return EXIT_FAILURE;
+	}
+
+	switch ( fractionBits )
+	{
+	case 16:
+		run<q16_16_t>( counting, filter );
+		break;
+
+	case 24:
+		run<q8_24_t>( counting, filter );
+		break;
+
+	default:
+		run<float>( counting, filter );
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,188 @@
+/*
+ * fleet.cpp
+ *
+ * Runs a fleet of WCMA nodes in lockstep with `BatchWCMA`. Every node sees
+ * its own synthetic weather. With `-c` every node is also run through the
+ * scalar `WCMA` and the results are compared bit by bit.
+ *
+ *  Created on: 2026-10-17
+ *      Author: agent
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+#include <unistd.h>
+
+#include "BatchWCMA.h"
+#include "WCMA.h"
+
+typedef BatchWCMA<Configuration::slotsPerDay, Configuration::retainDays, Configuration::retainSamples, float> batch_t;
+
+
+/**
+ * Platform that returns a value set from outside and never sleeps.
+ */
+class ReplayPlatform
+{
+	const float *value;
+
+public:
+
+	explicit ReplayPlatform( const float *v = 0 ) : value( v ) {}
+
+	float getLuminance()      { return *value; }
+	float getStorageVoltage() { return 0; }
+	void  resetClock()        {}
+	void  sleep( unsigned int ) {}
+};
+
+typedef WCMA<Configuration::slotsPerDay, Configuration::retainDays, Configuration::retainSamples, float, ReplayPlatform> scalar_t;
+
+
+/**
+ * Synthetic weather of the fleet.
+ *
+ * A half sine per day scaled by a cloud factor, which differs between days
+ * and nodes.
+ */
+class Weather
+{
+	std::vector<float> sun;  ///< per slot of the day
+	float              peak;
+
+public:
+
+	explicit Weather( const float p ) : sun( Configuration::slotsPerDay ), peak( p )
+	{
+		for ( std::size_t s = 0; s < sun.size(); ++s )
+		{
+			const float hour = 24. * s / sun.size();
+			const float v    = std::sin( M_PI * ( hour - 6 ) / 12 );
+			sun[s] = v > 0 ? v : 0;
+		}
+	}
+
+	float operator()( const std::size_t node, const std::size_t day, const std::size_t slot ) const
+	{
+		// integer hash of node and day, mapped to 0.2 up to 1
+		uint32_t h = node * 2654435761u ^ day * 40503u;
+		h ^= h >> 15;
+		h *= 2246822519u;
+		h ^= h >> 13;
+
+		const float cloud = .2 + .8 * ( h & 0xffff ) / 65535.;
+
+		return peak * cloud * sun[slot];
+	}
+};
+
+
+/**
+ * Compares two values bit by bit, so NaN equals NaN.
+ */
+template <typename T> bool identical( const T& a, const T& b )
+{
+	return !std::memcmp( &a, &b, sizeof( T ) );
+}
+
+
+int main( int argc, char *argv[] )
+{
+	std::size_t nodes = 10000;
+	std::size_t days  = 365;
+	float       peak  = 2;
+	bool        check = false;
+	int         opt;
+
+	while ( ( opt = getopt( argc, argv, "n:d:p:c" ) ) != -1 )
+		switch ( opt )
+		{
+		case 'n':
+			nodes = std::atoi( optarg );
+			break;
+
+		case 'd':
+			days = std::atoi( optarg );
+			break;
+
+		case 'p':
+			peak = std::atof( optarg );
+			break;
+
+		case 'c':
+			check = true;
+			break;
+
+		default:
+			std::cerr << "usage: " << argv[0] << " [-n nodes] [-d days] [-p peak] [-c]" << std::endl;
+			return EXIT_FAILURE;
+		}
+
+	const std::size_t slots = Configuration::slotsPerDay;
+	const Weather     weather( peak );
+
+	batch_t            batch( nodes );
+	std::vector<float> luminance( nodes );
+
+	// the scalar nodes read their luminance from `luminance`
+	std::vector<scalar_t> scalar;
+
+	if ( check )
+		for ( std::size_t m = 0; m < nodes; ++m )
+			scalar.push_back( scalar_t( ReplayPlatform( &luminance[m] ) ) );
+
+	for ( std::size_t m = 0; m < nodes; ++m )
+		luminance[m] = weather( m, 0, 0 );
+
+	batch.initialize( &luminance[0] );
+
+	for ( std::size_t m = 0; m < scalar.size(); ++m )
+		scalar[m].initialize();
+
+	double        batch_time  = 0;
+	double        slices      = 0;
+	unsigned long mismatches  = 0;
+
+	for ( std::size_t d = 0; d < days; ++d )
+		for ( std::size_t s = 0; s < slots; ++s )
+		{
+			for ( std::size_t m = 0; m < nodes; ++m )
+				luminance[m] = weather( m, d, s );
+
+			const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			batch.step( &luminance[0] );
+			batch_time += std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+
+			for ( std::size_t m = 0; m < nodes; ++m )
+				slices += batch.adaptive_slices()[m];
+
+			for ( std::size_t m = 0; m < scalar.size(); ++m )
+			{
+				scalar[m].calculateAdaptiveSlices();
+
+				if ( !identical( scalar[m].nextPrediction(), batch.nextPrediction()[m] )
+					|| !identical( scalar[m].last_24h_avg(), batch.last_24h_avg()[m] )
+					|| scalar[m].adaptive_slices != batch.adaptive_slices()[m] )
+					++mismatches;
+			}
+		}
+
+	const double steps = static_cast<double>( nodes ) * days * slots;
+
+	std::cout
+		<< "nodes          " << nodes << std::endl
+		<< "slots          " << days * slots << std::endl
+		<< "slices/slot    " << slices / steps << std::endl
+		<< "batch time     " << batch_time << " s" << std::endl
+		<< "node-slots/s   " << ( batch_time > 0 ? steps / batch_time : 0 ) << std::endl;
+
+	if ( check )
+		std::cout << "mismatches     " << mismatches << std::endl;
+
+	return mismatches ? EXIT_FAILURE : EXIT_SUCCESS;
+}
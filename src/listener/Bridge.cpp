@@ -0,0 +1,100 @@
+/*
+ * Bridge.cpp
+ *
+ *  Created on: 2026-10-17
+ *      Author: agent
+ */
+
+#include <array>
+#include <iostream>
+
+#include "Bridge.h"
+
+const std::size_t Bridge::max_datagram_size;
+
+
+Bridge::Bridge( ba::io_context& io, FramePool& p, const unsigned short udp_port ) :
+	socket( io, ba::ip::udp::endpoint( ba::ip::udp::v4(), udp_port ) ),
+	pool( p ),
+	frame( p.acquire() ),
+	overflow( max_datagram_size - sizeof( FramePool::Frame::header ) - sizeof( FramePool::Frame::payload ) ),
+	fallback( nullptr ),
+	dropped( 0 ),
+	unrouted( 0 )
+{
+}
+
+
+void Bridge::route( SerialLink& link )
+{
+	fallback = &link;
+}
+
+
+void Bridge::route( const uint8_t address, SerialLink& link )
+{
+	routes[address] = &link;
+}
+
+
+void Bridge::start()
+{
+	receive();
+}
+
+
+void Bridge::receive()
+{
+	const std::array<ba::mutable_buffer, 3> buffers =
+	{ {
+		ba::buffer( frame->header ),
+		ba::buffer( frame->payload ),
+		ba::buffer( overflow )
+	} };
+
+	socket.async_receive_from( buffers, sender,
+		[this]( const boost::system::error_code& error, const std::size_t size )
+		{
+			received( error, size );
+		} );
+}
+
+
+void Bridge::received( const boost::system::error_code& error, const std::size_t size )
+{
+	if ( error == ba::error::operation_aborted )
+		return;
+
+	if ( error )
+		std::cerr << "UDP receive: " << error.message() << std::endl;
+
+	const std::size_t header_size = FramePool::Frame::header_size;
+
+	// trailing bytes are not written, the controller would take them for
+	// the next frame
+	if ( error || size < header_size || size < header_size + frame->payload_size()
+		|| frame->payload_size() > FramePool::Frame::max_payload_size )
+		++dropped;
+	else
+	{
+#ifdef DEBUG
+		std::cerr << "address:\t0x"    << std::hex << int( frame->address() ) << std::endl;
+		std::cerr << "type:\t\t0x"     << int( frame->type() ) << std::dec << std::endl;
+		std::cerr << "payload_size:\t" << frame->payload_size() << std::endl;
+#endif
+
+		const std::map<uint8_t, SerialLink*>::const_iterator route = routes.find( frame->address() );
+		SerialLink *link = route != routes.end() ? route->second : fallback;
+
+		if ( link )
+		{
+			// a frame dropped by a full link returns to the pool
+			link->send( std::move( frame ) );
+			frame = pool.acquire();
+		}
+		else
+			++unrouted;
+	}
+
+	receive();
+}
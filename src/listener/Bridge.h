@@ -0,0 +1,104 @@
+/*
+ * Bridge.h
+ *
+ *  Created on: 2026-10-17
+ *      Author: agent
+ */
+
+#ifndef BRIDGE_H_T4WQ9LCX
+#define BRIDGE_H_T4WQ9LCX
+
+#include <cstdint>
+#include <map>
+#include <vector>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/udp.hpp>
+
+#include "FramePool.h"
+#include "SerialLink.h"
+
+/**
+ * Bridges a UDP port to the serial lines of controllers.
+ *
+ * Datagrams received on the UDP port are configuration frames for the
+ * sensor nodes: the address, the type and the size of the payload, one byte
+ * each, followed by the payload. Each frame goes to the link routed for its
+ * address, or to the default link if there is none. Frames without any
+ * link are dropped.
+ *
+ * A datagram is received straight into a frame of the pool, scattered into
+ * the header and the payload. Bytes beyond the largest payload go to a
+ * scratch buffer and are ignored. The frame is then moved to the queue of
+ * the link, so the bytes are neither copied here nor on the way to the
+ * serial line.
+ *
+ * All I/O is asynchronous on one `io_context`, shared by all bridges and
+ * links, so a single thread serves every port. The bridge never stops
+ * receiving. If a serial line is slower than the incoming datagrams, its
+ * queue fills up and the frames for it are dropped and counted by the link,
+ * while the frames for the other links still go through.
+ */
+class Bridge
+{
+public:
+
+	static const std::size_t max_datagram_size = 65536;
+
+	/**
+	 * @param io       Runs the I/O.
+	 * @param pool     Provides the frames.
+	 * @param udp_port Port the configuration frames are received on.
+	 */
+	Bridge( ba::io_context& io, FramePool& pool, const unsigned short udp_port );
+
+	/**
+	 * Sends the frames without a route of their own to `link`.
+	 */
+	void route( SerialLink& link );
+
+	/**
+	 * Sends the frames for the node `address` to `link`.
+	 */
+	void route( const uint8_t address, SerialLink& link );
+
+	/**
+	 * Starts receiving, the work is done by `io.run()`.
+	 */
+	void start();
+
+	/**
+	 * @return Datagrams dropped because they were no valid frame.
+	 */
+	unsigned long dropped_frames() const
+	{
+		return dropped;
+	}
+
+	/**
+	 * @return Frames dropped because no link was routed for them.
+	 */
+	unsigned long unrouted_frames() const
+	{
+		return unrouted;
+	}
+
+private:
+
+	ba::ip::udp::socket   socket;
+	ba::ip::udp::endpoint sender;
+
+	FramePool&           pool;
+	FramePool::Handle    frame;     ///< the datagram is received into
+	std::vector<uint8_t> overflow;  ///< takes the bytes that do not fit into `frame`
+
+	std::map<uint8_t, SerialLink*> routes;      ///< by the address of the node
+	SerialLink                    *fallback;     ///< for addresses without a route
+
+	unsigned long dropped;
+	unsigned long unrouted;
+
+	void receive();
+	void received( const boost::system::error_code& error, const std::size_t size );
+};
+
+#endif /* end of include guard: BRIDGE_H_T4WQ9LCX */
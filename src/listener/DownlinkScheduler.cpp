@@ -0,0 +1,122 @@
+/*
+ * DownlinkScheduler.cpp
+ *
+ *  Created on: 2026-10-17
+ *      Author: agent
+ */
+
+#include "DownlinkScheduler.h"
+
+const std::size_t DownlinkScheduler::priorities;
+
+const std::array<DownlinkScheduler::Clock::duration, DownlinkScheduler::priorities>
+	DownlinkScheduler::deadline =
+{ {
+	std::chrono::milliseconds( 100 ),
+	std::chrono::seconds( 1 ),
+	std::chrono::seconds( 10 )
+} };
+
+
+DownlinkScheduler::DownlinkScheduler( const Classes& c, const std::size_t l ) :
+	classes( c ),
+	limit( l ),
+	counters(),
+	waiting( 0 )
+{
+}
+
+
+bool DownlinkScheduler::push( FramePool::Handle&& frame, const Clock::time_point now )
+{
+	const Priority     priority = classes[frame->type()];
+	std::deque<Entry>& queue    = queues[priority];
+
+	for ( Entry& entry : queue )
+		if ( entry.frame->address() == frame->address() && entry.frame->type() == frame->type() )
+		{
+			// the outdated frame returns to the pool
+			entry.frame = std::move( frame );
+			++counters[priority].coalesced;
+			return true;
+		}
+
+	if ( full() )
+	{
+		std::size_t lowest = priorities;
+
+		while ( --lowest > priority && queues[lowest].empty() );
+
+		if ( lowest == priority )
+		{
+			++counters[priority].dropped;
+			return false;
+		}
+
+		// the newest frame has waited the shortest time
+		queues[lowest].pop_back();
+		++counters[lowest].dropped;
+		--waiting;
+	}
+
+	queue.push_back( Entry { std::move( frame ), now + deadline[priority] } );
+	++waiting;
+
+	return true;
+}
+
+
+FramePool::Handle DownlinkScheduler::pop( const Clock::time_point now )
+{
+	if ( !waiting )
+		return FramePool::Handle();
+
+	std::size_t first = priorities;
+
+	// ties go to the higher class
+	for ( std::size_t p = 0; p < priorities; ++p )
+		if ( !queues[p].empty() && ( first == priorities || queues[p].front().due < queues[first].front().due ) )
+			first = p;
+
+	Entry entry = std::move( queues[first].front() );
+	queues[first].pop_front();
+	--waiting;
+
+	++counters[first].sent;
+
+	if ( entry.due < now )
+		++counters[first].late;
+
+	return std::move( entry.frame );
+}
+
+
+void DownlinkScheduler::clear()
+{
+	for ( std::size_t p = 0; p < priorities; ++p )
+	{
+		counters[p].dropped += queues[p].size();
+		queues[p].clear();
+	}
+
+	waiting = 0;
+}
+
+
+const char *DownlinkScheduler::name( const Priority priority )
+{
+	switch ( priority )
+	{
+	case urgent:
+		return "urgent";
+
+	case normal:
+		return "normal";
+
+	case bulk:
+		return "bulk";
+
+	default:
+		return "";
+	}
+}
@@ -0,0 +1,146 @@
+/*
+ * DownlinkScheduler.h
+ *
+ *  Created on: 2026-10-17
+ *      Author: agent
+ */
+
+#ifndef DOWNLINKSCHEDULER_H_N3VK6TZP
+#define DOWNLINKSCHEDULER_H_N3VK6TZP
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+
+#include "FramePool.h"
+
+/**
+ * Orders the configuration frames waiting for the serial line of a
+ * controller.
+ *
+ * Every frame type belongs to a priority class, see `Classes`. A frame is
+ * due within the `deadline` of its class after it arrived. The frame due
+ * first is written first, so an urgent frame overtakes a burst of bulk
+ * frames but a bulk frame is not held up forever. A frame that missed its
+ * deadline is still written, but counted as late. Dropping it would only
+ * make the operator push it again.
+ *
+ * A frame replaces a waiting one for the same node and of the same type,
+ * which is outdated by it. It keeps the place and the deadline of the one
+ * it replaces.
+ *
+ * The classes share one limit. If the queue is full, a new frame takes the
+ * place of the newest frame of the lowest class below its own, which is
+ * dropped. A burst of bulk frames hence never keeps an urgent frame out. If
+ * there is no such frame, the new one is dropped.
+ *
+ * Within a class the deadlines are in the order the frames arrive, so each
+ * class is a FIFO and the frame due first is at the front of one of them.
+ */
+class DownlinkScheduler
+{
+public:
+
+	typedef std::chrono::steady_clock Clock;
+
+	enum Priority
+	{
+		urgent,  ///< e.g. reconfiguring a node that runs out of energy
+		normal,
+		bulk
+	};
+
+	static const std::size_t priorities = bulk + 1;
+
+	/**
+	 * Time a frame of each class may wait at most.
+	 */
+	static const std::array<Clock::duration, priorities> deadline;
+
+	/**
+	 * The class of each frame type.
+	 */
+	typedef std::array<Priority, 256> Classes;
+
+	struct Counters
+	{
+		unsigned long sent;       ///< taken for writing
+		unsigned long coalesced;  ///< replaced by a newer frame
+		unsigned long late;       ///< taken after the deadline
+		unsigned long dropped;    ///< queue full, made room or device closed
+	};
+
+	/**
+	 * @param classes The class of each frame type.
+	 * @param limit   Frames waiting at most.
+	 */
+	DownlinkScheduler( const Classes& classes, const std::size_t limit );
+
+	/**
+	 * Queues a frame, or replaces the waiting one it outdates.
+	 *
+	 * @return `false` if the frame was dropped since the queue is full of
+	 * frames of its own class or higher ones.
+	 */
+	bool push( FramePool::Handle&& frame, const Clock::time_point now );
+
+	/**
+	 * Takes the frame due first.
+	 *
+	 * @return The frame, empty if none is waiting.
+	 */
+	FramePool::Handle pop( const Clock::time_point now );
+
+	/**
+	 * Counts a frame that is not written as dropped.
+	 */
+	void drop( const FramePool::Frame& frame )
+	{
+		++counters[classes[frame.type()]].dropped;
+	}
+
+	/**
+	 * Drops all waiting frames.
+	 */
+	void clear();
+
+	std::size_t size() const
+	{
+		return waiting;
+	}
+
+	bool empty() const
+	{
+		return !waiting;
+	}
+
+	bool full() const
+	{
+		return waiting >= limit;
+	}
+
+	const Counters& statistics( const Priority priority ) const
+	{
+		return counters[priority];
+	}
+
+	static const char *name( const Priority priority );
+
+private:
+
+	struct Entry
+	{
+		FramePool::Handle  frame;
+		Clock::time_point  due;
+	};
+
+	const Classes     classes;
+	const std::size_t limit;
+
+	std::array<std::deque<Entry>, priorities> queues;  ///< waiting frames of each class, oldest first
+	std::array<Counters, priorities>          counters;
+	std::size_t                               waiting;
+};
+
+#endif /* end of include guard: DOWNLINKSCHEDULER_H_N3VK6TZP */
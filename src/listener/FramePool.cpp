@@ -0,0 +1,26 @@
+/*
+ * FramePool.cpp
+ *
+ *  Created on: 2026-10-17
+ *      Author: agent
+ */
+
+#include "FramePool.h"
+
+const std::size_t FramePool::Frame::header_size;
+const std::size_t FramePool::Frame::max_payload_size;
+
+
+FramePool::Handle FramePool::acquire()
+{
+	if ( available.empty() )
+	{
+		frames.emplace_back( new Frame );
+		available.push_back( frames.back().get() );
+	}
+
+	Frame *frame = available.back();
+	available.pop_back();
+
+	return Handle( frame, Release( this ) );
+}
@@ -0,0 +1,107 @@
+/*
+ * FramePool.h
+ *
+ *  Created on: 2026-10-17
+ *      Author: agent
+ */
+
+#ifndef FRAMEPOOL_H_W5JC8NEB
+#define FRAMEPOOL_H_W5JC8NEB
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "WireFormat.h"
+
+/**
+ * Recycles the buffers of the configuration frames.
+ *
+ * A frame is received into a buffer taken from the pool and handed on from
+ * the UDP socket to the queue of a serial line by moving its handle. It is
+ * never copied. Once written, the handle is destroyed and the buffer returns
+ * to the pool. New buffers are only allocated while more frames are in use
+ * than ever before, which the queue limits bound.
+ *
+ * The pool must outlive all handles taken from it.
+ */
+class FramePool
+{
+public:
+
+	/**
+	 * A configuration frame, header and payload as the controller reads them.
+	 */
+	struct Frame
+	{
+		static const std::size_t header_size = 3;
+
+		/**
+		 * Largest payload the controller accepts, see `Serial` in
+		 * `Controller.h`.
+		 */
+		static const std::size_t max_payload_size = WireFormat::maxFrameSize;
+
+		uint8_t header[header_size];        ///< address, type and payload size
+		uint8_t payload[max_payload_size];
+
+		uint8_t address() const
+		{
+			return header[0];
+		}
+
+		uint8_t type() const
+		{
+			return header[1];
+		}
+
+		std::size_t payload_size() const
+		{
+			return header[2];
+		}
+	};
+
+	/**
+	 * Returns a frame to the pool it was taken from.
+	 */
+	class Release
+	{
+	public:
+
+		explicit Release( FramePool *p = nullptr ) :
+			pool( p )
+		{
+		}
+
+		void operator()( Frame *frame ) const
+		{
+			pool->available.push_back( frame );
+		}
+
+	private:
+
+		FramePool *pool;
+	};
+
+	typedef std::unique_ptr<Frame, Release> Handle;
+
+	/**
+	 * @return A frame of undefined content.
+	 */
+	Handle acquire();
+
+	/**
+	 * @return Frames allocated so far.
+	 */
+	std::size_t allocated() const
+	{
+		return frames.size();
+	}
+
+private:
+
+	std::vector<std::unique_ptr<Frame>> frames;     ///< all frames, in use or not
+	std::vector<Frame*>                 available;  ///< frames not in use
+};
+
+#endif /* end of include guard: FRAMEPOOL_H_W5JC8NEB */
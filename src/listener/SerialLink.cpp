@@ -0,0 +1,174 @@
+/*
+ * SerialLink.cpp
+ *
+ *  Created on: 2026-10-17
+ *      Author: agent
+ */
+
+#include <iostream>
+#include <boost/asio/write.hpp>
+
+#include "SerialLink.h"
+
+const std::chrono::seconds SerialLink::retry_interval( 1 );
+const std::size_t          SerialLink::max_gather;
+
+
+SerialLink::SerialLink( ba::io_context& io, const std::string& d, const bool text,
+	const DownlinkScheduler::Classes& classes, const std::size_t limit ) :
+	port( io ),
+	timer( io ),
+	device( d ),
+	scheduler( classes, limit ),
+	connected( false ),
+	reopened( 0 ),
+	reader( port, text, std::cout,
+		[this]( const boost::system::error_code& error )
+		{
+			fail( "serial read", error );
+		} )
+{
+}
+
+
+void SerialLink::start()
+{
+	open();
+
+	if ( !connected )
+		retry();
+}
+
+
+void SerialLink::open()
+{
+	boost::system::error_code ec;
+
+	if ( port.open( device, ec ) )
+		return;
+
+	// serial port setup, a later call would clear the error of an earlier one
+	if ( port.set_option( ba::serial_port::baud_rate( 2000000 ), ec )
+		|| port.set_option( ba::serial_port::parity( ba::serial_port::parity::odd ), ec ) )
+	{
+		std::cerr << device << ": serial setup: " << ec.message() << std::endl;
+
+		port.close( ec );
+		return;
+	}
+
+#ifdef DEBUG
+	std::cerr << "Opened " << device << std::endl;
+#endif
+
+	connected = true;
+	reader.start();
+}
+
+
+bool SerialLink::send( FramePool::Handle&& frame )
+{
+	if ( !connected )
+	{
+		scheduler.drop( *frame );
+		return false;
+	}
+
+	if ( !scheduler.push( std::move( frame ), DownlinkScheduler::Clock::now() ) )
+		return false;
+
+	if ( writing.empty() )
+		write();
+
+	return true;
+}
+
+
+void SerialLink::fail( const char *what, const boost::system::error_code& error )
+{
+	// the read and a write may both fail on the same disconnect
+	if ( !connected )
+		return;
+
+	std::cerr << device << ": " << what << ": " << error.message() << std::endl;
+
+	connected = false;
+
+	// cancels the pending operations, their buffers are not touched anymore
+	boost::system::error_code ec;
+	port.close( ec );
+
+	for ( const FramePool::Handle& frame : writing )
+		scheduler.drop( *frame );
+
+	writing.clear();
+	scheduler.clear();
+
+	retry();
+}
+
+
+void SerialLink::retry()
+{
+	timer.expires_after( retry_interval );
+	timer.async_wait(
+		[this]( const boost::system::error_code& error )
+		{
+			if ( error )
+				return;
+
+			open();
+
+			if ( connected )
+				++reopened;
+			else
+				retry();
+		} );
+}
+
+
+void SerialLink::write()
+{
+	const DownlinkScheduler::Clock::time_point now = DownlinkScheduler::Clock::now();
+
+	gather.clear();
+
+	while ( writing.size() < max_gather && !scheduler.empty() )
+	{
+		FramePool::Handle frame = scheduler.pop( now );
+
+		gather.push_back( ba::buffer( frame->header ) );
+		gather.push_back( ba::buffer( frame->payload, frame->payload_size() ) );
+
+		writing.push_back( std::move( frame ) );
+	}
+
+	ba::async_write( port, gather,
+		[this]( const boost::system::error_code& error, std::size_t )
+		{
+			written( error );
+		} );
+}
+
+
+void SerialLink::written( const boost::system::error_code& error )
+{
+	if ( error == ba::error::operation_aborted )
+		return;
+
+	if ( error )
+	{
+		fail( "serial write", error );
+		return;
+	}
+
+#ifdef DEBUG
+	std::cerr << "Sent " << writing.size() << " frames, " << ba::buffer_size( gather ) << " octets to "
+		<< device << std::endl;
+#endif
+
+	writing.clear();
+
+	if ( !scheduler.empty() )
+		write();
+}
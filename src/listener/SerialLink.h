@@ -0,0 +1,136 @@
+/*
+ * SerialLink.h
+ *
+ *  Created on: 2026-10-17
+ *      Author: agent
+ */
+
+#ifndef SERIALLINK_H_R2DM7QWA
+#define SERIALLINK_H_R2DM7QWA
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/serial_port.hpp>
+#include <boost/asio/steady_timer.hpp>
+
+#include "DownlinkScheduler.h"
+#include "FramePool.h"
+#include "SerialReader.h"
+
+namespace ba {
+	using namespace boost::asio;
+}
+
+/**
+ * The serial line of one controller.
+ *
+ * Frames for the controller are queued and written, each completely, while
+ * the line is read by a `SerialReader`. The order is decided by a
+ * `DownlinkScheduler`. When the line is idle, the frames due first, up to
+ * `max_gather`, are written together by one gather write of their headers
+ * and payloads straight from their buffers.
+ *
+ * The device is opened by `start()`. If that fails, or if a read or write
+ * fails later on, e.g. because the USB device was unplugged or enumerated
+ * anew, the port is closed and opened again once per `retry_interval` until
+ * it succeeds. Frames sent in the meantime are dropped, the nodes send
+ * their readings again anyway and the configuration frames are pushed
+ * again by the operator.
+ */
+class SerialLink
+{
+public:
+
+	/**
+	 * Time between two attempts to open the device.
+	 */
+	static const std::chrono::seconds retry_interval;
+
+	/**
+	 * Frames written by one call at most.
+	 */
+	static const std::size_t max_gather = 16;
+
+	/**
+	 * @param io          Runs the I/O.
+	 * @param device      Path of the serial device.
+	 * @param text        Whether the controller prints text.
+	 * @param classes     The priority class of each frame type.
+	 * @param queue_limit Frames queued at most.
+	 */
+	SerialLink( ba::io_context& io, const std::string& device, const bool text,
+		const DownlinkScheduler::Classes& classes, const std::size_t queue_limit );
+
+	/**
+	 * Opens the device, the work is done by `io.run()`.
+	 */
+	void start();
+
+	/**
+	 * Queues a frame for the controller.
+	 *
+	 * @return `false` if the frame was dropped since the queue is full or
+	 * the device is not open. A frame that replaces a queued one is not
+	 * dropped.
+	 */
+	bool send( FramePool::Handle&& frame );
+
+	const std::string& device_name() const
+	{
+		return device;
+	}
+
+	/**
+	 * @return What became of the frames of a priority class.
+	 */
+	const DownlinkScheduler::Counters& statistics( const DownlinkScheduler::Priority priority ) const
+	{
+		return scheduler.statistics( priority );
+	}
+
+	const SerialReader& serial_reader() const
+	{
+		return reader;
+	}
+
+	/**
+	 * @return Times the device was opened again.
+	 */
+	unsigned long reconnects() const
+	{
+		return reopened;
+	}
+
+private:
+
+	ba::serial_port   port;
+	ba::steady_timer  timer;
+	const std::string device;
+
+	DownlinkScheduler              scheduler;
+	std::vector<FramePool::Handle> writing;  ///< frames being written
+	std::vector<ba::const_buffer>  gather;   ///< buffers of `writing`
+
+	bool          connected;
+	unsigned long reopened;
+
+	SerialReader reader;
+
+	void open();
+
+	/**
+	 * Closes the port after an error and retries later.
+	 */
+	void fail( const char *what, const boost::system::error_code& error );
+
+	void retry();
+
+	void write();
+	void written( const boost::system::error_code& error );
+};
+
+#endif /* end of include guard: SERIALLINK_H_R2DM7QWA */
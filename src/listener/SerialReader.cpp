@@ -0,0 +1,124 @@
+/*
+ * SerialReader.cpp
+ *
+ *  Created on: 2026-10-17
+ *      Author: agent
+ */
+
+#include <cstring>
+
+#include "SerialReader.h"
+
+namespace ba {
+	using namespace boost::asio;
+}
+
+const std::size_t SerialReader::buffer_size;
+
+
+SerialReader::SerialReader( ba::serial_port& p, const bool t, std::ostream& o, const Failed& f ) :
+	port( p ),
+	buffer( buffer_size ),
+	filled( 0 ),
+	scanned( 0 ),
+	discarding( false ),
+	text( t ),
+	out( o ),
+	overlong( 0 ),
+	failed( f )
+{
+}
+
+
+void SerialReader::start()
+{
+	// a record cut off by a reconnect is of no use
+	filled = scanned = 0;
+	discarding = false;
+
+	read();
+}
+
+
+void SerialReader::read()
+{
+	port.async_read_some( ba::buffer( buffer.data() + filled, buffer.size() - filled ),
+		[this]( const boost::system::error_code& error, const std::size_t size )
+		{
+			read_done( error, size );
+		} );
+}
+
+
+void SerialReader::read_done( const boost::system::error_code& error, const std::size_t size )
+{
+	if ( error == ba::error::operation_aborted )
+		return;
+
+	if ( error )
+	{
+		failed( error );
+		return;
+	}
+
+	filled += size;
+
+	split();
+
+	const std::string output = batch.str();
+
+	if ( !output.empty() )
+	{
+		out.write( output.data(), output.size() );
+		out.flush();
+
+		batch.str( std::string() );
+	}
+
+	read();
+}
+
+
+void SerialReader::split()
+{
+	const uint8_t delimiter = text ? '\n' : 0;
+
+	std::size_t begin = 0;
+
+	for ( ;; )
+	{
+		const uint8_t *found = static_cast<const uint8_t*>(
+			std::memchr( buffer.data() + scanned, delimiter, filled - scanned ) );
+
+		if ( !found )
+			break;
+
+		const std::size_t end = found - buffer.data();
+
+		if ( discarding )
+			discarding = false;
+		else if ( text )
+			batch.write( reinterpret_cast<const char*>( buffer.data() + begin ), end + 1 - begin );
+		else if ( end > begin )
+			decoder.decode( buffer.data() + begin, end - begin, batch );
+
+		begin = scanned = end + 1;
+	}
+
+	// a record as large as the buffer never ends, drop it up to the next
+	// delimiter to resynchronise
+	if ( !begin && filled == buffer.size() )
+	{
+		if ( !discarding )
+			++overlong;
+
+		discarding = true;
+		filled = scanned = 0;
+		return;
+	}
+
+	std::memmove( buffer.data(), buffer.data() + begin, filled - begin );
+
+	filled -= begin;
+	scanned = filled;
+}
@@ -0,0 +1,94 @@
+/*
+ * SerialReader.h
+ *
+ *  Created on: 2026-10-17
+ *      Author: agent
+ */
+
+#ifndef SERIALREADER_H_H8YB3KUF
+#define SERIALREADER_H_H8YB3KUF
+
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <sstream>
+#include <vector>
+#include <boost/asio/serial_port.hpp>
+
+#include "UplinkDecoder.h"
+
+/**
+ * Reads the serial line of a controller in bulk.
+ *
+ * Each read takes whatever the driver has buffered, up to the free space of
+ * a large buffer. The complete records in it, delimited by a zero byte or
+ * by a newline for text, are processed and their output is written in one
+ * go. The incomplete record at the end is moved to the front of the buffer
+ * and completed by the next read.
+ *
+ * A failing read, e.g. when the device is unplugged, is reported to the
+ * owner of the port, which reopens it and starts reading again.
+ */
+class SerialReader
+{
+public:
+
+	typedef std::function<void( const boost::system::error_code& )> Failed;
+
+	static const std::size_t buffer_size = 65536;
+
+	/**
+	 * @param port   The opened serial line.
+	 * @param text   Whether the controller prints text, which is passed
+	 *               through, instead of binary records, which are decoded.
+	 * @param out    Destination of the output.
+	 * @param failed Called when a read fails, reading then stops.
+	 */
+	SerialReader( boost::asio::serial_port& port, const bool text, std::ostream& out,
+		const Failed& failed );
+
+	/**
+	 * Starts reading with an empty buffer, the work is done by the
+	 * `io_context` of the port.
+	 */
+	void start();
+
+	/**
+	 * @return Records dropped since they did not fit into the buffer.
+	 */
+	unsigned long overlong_records() const
+	{
+		return overlong;
+	}
+
+	const UplinkDecoder& uplink_decoder() const
+	{
+		return decoder;
+	}
+
+private:
+
+	boost::asio::serial_port& port;
+
+	std::vector<uint8_t> buffer;
+	std::size_t          filled;   ///< bytes in `buffer`
+	std::size_t          scanned;  ///< bytes in `buffer` known to hold no delimiter
+	bool                 discarding;  ///< skipping the rest of an overlong record
+
+	UplinkDecoder      decoder;
+	const bool         text;
+	std::ostream&      out;
+	std::ostringstream batch;      ///< output of one read
+	unsigned long      overlong;
+	const Failed       failed;
+
+	void read();
+	void read_done( const boost::system::error_code& error, const std::size_t size );
+
+	/**
+	 * Processes the complete records in the buffer.
+	 */
+	void split();
+};
+
+#endif /* end of include guard: SERIALREADER_H_H8YB3KUF */
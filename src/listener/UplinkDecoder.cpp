@@ -0,0 +1,92 @@
+/*
+ * UplinkDecoder.cpp
+ *
+ *  Created on: 2026-10-17
+ *      Author: agent
+ */
+
+#include "UplinkDecoder.h"
+#include "Cobs.h"
+#include "WireFormat.h"
+
+namespace
+{
+	/**
+	 * Longest record the controller sends, longer blocks are garbage.
+	 */
+	const std::size_t maxRecordSize = 2 + WireFormat::maxFrameSize;
+}
+
+
+void UplinkDecoder::decode( const uint8_t *block, const std::size_t block_size, std::ostream& out )
+{
+	record.resize( block_size );
+
+	const std::size_t size = block_size <= Cobs::maxEncodedSize( maxRecordSize ) ?
+		Cobs::decode( block, block_size, record.data() ) : 0;
+
+	WireFormat::Header header;
+
+	if ( size < 2 || !WireFormat::decodeHeader( &record[2], size - 2, header ) )
+	{
+		++invalid;
+		return;
+	}
+
+	const int      rssi   = static_cast<int8_t>( record[0] );
+	const int      lqi    = record[1];
+	const uint8_t *frame  = &record[2];
+	const uint8_t  length = static_cast<uint8_t>( size - 2 );
+
+	UplinkBatch::Reading readings[UplinkBatch::capacity];
+	EnergyLog::Record    records[WireFormat::maxFrameSize / WireFormat::recordSize];
+	unsigned int         n = 0;
+
+	switch ( header.type )
+	{
+	case WireFormat::reading:
+		n = WireFormat::decodeReading( frame, length, readings[0] );
+		break;
+
+	case WireFormat::batch:
+		n = WireFormat::decodeBatch( frame, length, readings );
+		break;
+
+	case WireFormat::energyLog:
+		n = WireFormat::decodeEnergyLog( frame, length, records );
+		break;
+
+	default:
+		break;
+	}
+
+	if ( !n )
+		++invalid;
+
+	for ( unsigned int i = 0; i < n; ++i )
+	{
+		out << ( header.type == WireFormat::energyLog ? "energy," : "reading," )
+			<< int( header.node_id ) << ',' << rssi << ',' << lqi;
+
+		if ( header.type == WireFormat::energyLog )
+		{
+			out << ',' << records[i].sequence;
+
+			for ( uint8_t p = 0; p < EnergyLog::phases; ++p )
+				out << ',' << records[i].time[p];
+
+			for ( uint8_t p = 0; p < EnergyLog::phases; ++p )
+				out << ',' << records[i].energy[p];
+		}
+		else
+			out
+				<< ',' << readings[i].temperature / 10.
+				<< ',' << readings[i].humidity / 10.
+				<< ',' << readings[i].adaptive_slices
+				<< ',' << readings[i].sleep_time
+				<< ',' << readings[i].battery_level / 1000.
+				<< ',' << UplinkBatch::age( readings, static_cast<uint8_t>( n ), static_cast<uint8_t>( i ) );
+
+		out << '\n';
+	}
+}
@@ -0,0 +1,58 @@
+/*
+ * UplinkDecoder.h
+ *
+ *  Created on: 2026-10-17
+ *      Author: agent
+ */
+
+#ifndef UPLINKDECODER_H_Z5GM1QPA
+#define UPLINKDECODER_H_Z5GM1QPA
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+/**
+ * Decodes the binary records of the controller.
+ *
+ * The controller forwards every frame it receives as a record of the RSSI,
+ * the LQI and the frame, see `Controller::forwardPacket()`. The records are
+ * encoded with `Cobs` and enclosed in zero bytes. Each record is written
+ * as lines of comma separated values:
+ *
+ *     reading,node,rssi,lqi,temperature,humidity,adaptive_slices,sleep_time,battery_level,age
+ *     energy,node,rssi,lqi,sequence,time...,energy...
+ *
+ * with one line per reading or energy log record in the frame. `age` is the
+ * time in seconds from the reading to the newest reading of the frame, see
+ * `UplinkBatch::age()`. Records that
+ * can not be decoded, e.g. debug text of the controller, are counted and
+ * skipped.
+ */
+class UplinkDecoder
+{
+	std::vector<uint8_t> record;
+	unsigned long        invalid;
+
+public:
+
+	UplinkDecoder() : invalid( 0 ) {}
+
+	/**
+	 * Decodes one record.
+	 *
+	 * @param block The encoded record without the delimiter.
+	 */
+	void decode( const uint8_t *block, const std::size_t block_size, std::ostream& out );
+
+	/**
+	 * @return Records that could not be decoded.
+	 */
+	unsigned long invalid_records() const
+	{
+		return invalid;
+	}
+};
+
+#endif /* end of include guard: UPLINKDECODER_H_Z5GM1QPA */
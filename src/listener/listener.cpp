@@ -1,125 +1,253 @@
-#define DEBUG
-
+#include <cstdlib>
 #include <iostream>
-#include <thread>
-#include <boost/asio/io_service.hpp>
-#include <boost/asio/serial_port.hpp>
-#include <boost/asio/ip/udp.hpp>
-#include <boost/asio/read.hpp>
-
-namespace ba {
-	using namespace boost::asio;
-}
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/signal_set.hpp>
+
+#include "Bridge.h"
 
-const unsigned int max_datagram_size = 65536;
-
-// packet structure of the datagram received on the UDP socket
-static union {
-	struct {
-		uint8_t address;
-		uint8_t type;
-		uint8_t size;
-		uint8_t payload[max_datagram_size-3];
-	} data_frame;
-	uint8_t DATA_FRAME[max_datagram_size];
-};
-
-template <typename Socket>
-unsigned int udp_receive( Socket& socket )
+namespace
 {
-	unsigned int received_size;
-	unsigned int payload_size;
+	/**
+	 * Routes the frames for one node, `udp_port/address=device`.
+	 */
+	struct Route
+	{
+		unsigned short udp_port;
+		uint8_t        address;
+		std::string    device;
+	};
 
-	received_size = socket.receive( boost::asio::buffer( DATA_FRAME, max_datagram_size ));
-	payload_size  = received_size - sizeof( data_frame ) + sizeof( data_frame.payload );
+	/**
+	 * Reads a number of at most `max`, decimal or with a `0x` prefix.
+	 */
+	bool parse_number( const std::string& s, const unsigned long max, unsigned long& n )
+	{
+		char *end;
 
-#ifdef DEBUG
-	std::cerr << "address:\t0x"    << int(data_frame.address) << std::endl;
-	std::cerr << "type:\t\t0x"     << int(data_frame.type)    << std::endl;
-	std::cerr << "payload_size:\t" << payload_size            << std::endl;
-	std::cerr << "payload:\t"      << data_frame.payload      << std::endl;
-#endif
+		n = std::strtoul( s.c_str(), &end, 0 );
 
-	return received_size;
-}
+		return !s.empty() && !*end && n <= max;
+	}
 
-template <typename Port>
-void serial_send( Port& port, uint8_t *frame, unsigned int size )
-{
-#ifdef DEBUG
-	std::cerr << "Sending data " << size << " octets to Sentio…"
-		<< std::endl << std::endl;
-#endif
+	bool parse_route( const std::string& s, Route& route )
+	{
+		const std::size_t slash = s.find( '/' );
+		const std::size_t equal = s.find( '=', slash );
+		unsigned long     port, address;
 
-	port.write_some( ba::buffer( frame, size ) );
-}
+		if ( slash == std::string::npos || equal == std::string::npos || equal + 1 == s.size()
+			|| !parse_number( s.substr( 0, slash ), 65535, port )
+			|| !parse_number( s.substr( slash + 1, equal - slash - 1 ), 255, address ) )
+			return false;
 
-template <typename Socket, typename Port>
-void udp_to_serial( Socket &socket, Port &port)
-{
-	unsigned int received_size;
+		route.udp_port = port;
+		route.address  = address;
+		route.device   = s.substr( equal + 1 );
 
-	while ( true )
-	{
-		received_size = udp_receive( socket );
-		serial_send( port, DATA_FRAME, received_size );
+		return true;
 	}
-}
 
-template <typename Port>
-void serial_read( Port &port)
-{
-	const unsigned int READ_BUFFER_SIZE = 1;
-	std::vector<char> buffer( READ_BUFFER_SIZE );
+	/**
+	 * Reads the class of a frame type, `type=class`.
+	 */
+	bool parse_class( const std::string& s, DownlinkScheduler::Classes& classes )
+	{
+		const std::size_t equal = s.find( '=' );
+		unsigned long     type;
+
+		if ( equal == std::string::npos || !parse_number( s.substr( 0, equal ), 255, type ) )
+			return false;
 
-	while ( true )
+		for ( std::size_t p = 0; p < DownlinkScheduler::priorities; ++p )
+		{
+			const DownlinkScheduler::Priority priority = static_cast<DownlinkScheduler::Priority>( p );
+
+			if ( s.substr( equal + 1 ) == DownlinkScheduler::name( priority ) )
+			{
+				classes[type] = priority;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	/**
+	 * Splits `device[:udp_port]`, the port is 0 if it is missing.
+	 */
+	bool parse_link( const std::string& s, std::string& device, unsigned short& udp_port )
 	{
-		boost::asio::read( port, boost::asio::buffer( buffer ));
-		std::cout << buffer[0];
+		const std::size_t colon = s.rfind( ':' );
+		unsigned long     port  = 0;
+
+		if ( colon != std::string::npos && !parse_number( s.substr( colon + 1 ), 65535, port ) )
+			return false;
+
+		device   = s.substr( 0, colon );
+		udp_port = port;
+
+		return !device.empty();
 	}
 }
 
-int main( int argc, char const *argv[] )
+int main( int argc, char *argv[] )
 {
-	const std::string  device   = argc >= 2 ? argv[1] : "/dev/ttyUSB0";
-	const unsigned int udp_port = argc >= 3 ? std::atoi( argv[2] ) : 1234;
+	bool                       text = false;
+	std::vector<Route>         routes;
+	DownlinkScheduler::Classes classes;
+	int                        opt;
 
-#ifdef DEBUG
-	std::cerr << "Opening UDP port:\t"      << udp_port << std::endl;
-	std::cerr << "Forwarding packets to:\t" << device   << std::endl << std::endl;
-#endif
+	classes.fill( DownlinkScheduler::normal );
+
+	const std::string usage = std::string( "usage: " ) + argv[0]
+		+ " [-t] [-p type=urgent|normal|bulk]... [-r udp_port/address=device]..."
+		+ " [device[:udp_port]]...";
+
+	// `-t` if the controllers print text instead of forwarding binary frames,
+	// `-p` to change the priority class of a frame type,
+	// `-r` to send the frames for one node to another controller
+	while ( ( opt = getopt( argc, argv, "tp:r:" ) ) != -1 )
+		switch ( opt )
+		{
+		case 't':
+			text = true;
+			break;
+
+		case 'p':
+			if ( !parse_class( optarg, classes ) )
+			{
+				std::cerr << "invalid class " << optarg << std::endl << usage << std::endl;
+				return EXIT_FAILURE;
+			}
+			break;
+
+		case 'r':
+			routes.emplace_back();
+
+			if ( !parse_route( optarg, routes.back() ) )
+			{
+				std::cerr << "invalid route " << optarg << std::endl << usage << std::endl;
+				return EXIT_FAILURE;
+			}
+			break;
+
+		default:
+			std::cerr << usage << std::endl;
+			return EXIT_FAILURE;
+		}
+
+	std::vector<std::string> arguments( argv + optind, argv + argc );
+
+	if ( arguments.empty() )
+		arguments.push_back( "/dev/ttyUSB0:1234" );
+
+	// configuration frames waiting for a serial line at most
+	const std::size_t queue_limit = 64;
+
+	// the output is written in batches, no need to keep it in sync with stdio
+	std::ios::sync_with_stdio( false );
 
 	try
 	{
-		// for socket IO
-		ba::io_service net_io;
-		ba::ip::udp::socket net_sock( net_io, ba::ip::udp::endpoint( ba::ip::udp::v4(), udp_port));
+		ba::io_context io;
+
+		// destroyed last, the links and bridges hold frames of it
+		FramePool pool;
 
-		// for serial IO
-		ba::io_service serial_io;
-		ba::serial_port port( serial_io );
-		boost::system::error_code ec;
+		std::map<std::string, std::unique_ptr<SerialLink>> links;
+		std::map<unsigned short, std::unique_ptr<Bridge>>   bridges;
 
-		if ( port.open( device, ec ) )
+		const auto link = [&]( const std::string& device ) -> SerialLink&
 		{
-			std::cout << "cannot open " << device << std::endl;
-			return EXIT_FAILURE;
+			std::unique_ptr<SerialLink>& l = links[device];
+
+			if ( !l )
+				l.reset( new SerialLink( io, device, text, classes, queue_limit ) );
+
+			return *l;
+		};
+
+		const auto bridge = [&]( const unsigned short udp_port ) -> Bridge&
+		{
+			std::unique_ptr<Bridge>& b = bridges[udp_port];
+
+			if ( !b )
+				b.reset( new Bridge( io, pool, udp_port ) );
+
+			return *b;
+		};
+
+		for ( const std::string& argument : arguments )
+		{
+			std::string    device;
+			unsigned short udp_port;
+
+			if ( !parse_link( argument, device, udp_port ) )
+			{
+				std::cerr << "invalid device " << argument << std::endl << usage << std::endl;
+				return EXIT_FAILURE;
+			}
+
+			SerialLink& l = link( device );
+
+			if ( udp_port )
+			{
+#ifdef DEBUG
+				std::cerr << "Forwarding UDP port " << udp_port << " to " << device << std::endl;
+#endif
+
+				bridge( udp_port ).route( l );
+			}
+		}
+
+		for ( const Route& route : routes )
+		{
+#ifdef DEBUG
+			std::cerr << "Forwarding node " << int( route.address ) << " from UDP port "
+				<< route.udp_port << " to " << route.device << std::endl;
+#endif
+
+			bridge( route.udp_port ).route( route.address, link( route.device ) );
 		}
 
-		// serial port setup
-		port.set_option( ba::serial_port::baud_rate( 2000000 ) );
-		port.set_option( ba::serial_port::parity   ( ba::serial_port::parity::odd ) );
+		for ( auto& l : links )
+			l.second->start();
 
-		std::thread t_udp_read_and_serial_send(
-			&udp_to_serial<ba::ip::udp::socket, ba::serial_port>, std::ref( net_sock ), std::ref( port ) );
+		for ( auto& b : bridges )
+			b.second->start();
 
-		std::thread t_serial_read(
-			&serial_read<ba::serial_port>, std::ref( port ) );
+		ba::signal_set signals( io, SIGINT, SIGTERM );
+		signals.async_wait( [&]( const boost::system::error_code&, int ) { io.stop(); } );
 
-		t_udp_read_and_serial_send.join();
+		io.run();
 
-		net_sock.close();
-		port.close();
+		for ( const auto& b : bridges )
+			std::cerr << "UDP port " << b.first << ": " << b.second->dropped_frames() << " invalid, "
+				<< b.second->unrouted_frames() << " unrouted" << std::endl;
+
+		for ( const auto& l : links )
+		{
+			const SerialReader& reader = l.second->serial_reader();
+
+			std::cerr << l.first << ": " << l.second->reconnects() << " reconnects, "
+				<< reader.uplink_decoder().invalid_records() << " invalid records, "
+				<< reader.overlong_records() << " overlong records" << std::endl;
+
+			for ( std::size_t p = 0; p < DownlinkScheduler::priorities; ++p )
+			{
+				const DownlinkScheduler::Priority  priority = static_cast<DownlinkScheduler::Priority>( p );
+				const DownlinkScheduler::Counters& c        = l.second->statistics( priority );
+
+				std::cerr << "\t" << DownlinkScheduler::name( priority ) << ": " << c.sent << " sent, "
+					<< c.coalesced << " coalesced, " << c.late << " late, " << c.dropped << " dropped"
+					<< std::endl;
+			}
+		}
 
 		return EXIT_SUCCESS;
 	}
@@ -8,19 +8,14 @@
 #ifndef PAYLOAD_PACKET_H_MB9NXB2W
 #define PAYLOAD_PACKET_H_MB9NXB2W
 
+#include "WireFormat.h"
+
 namespace Packet
 {
-	static union {
-		struct {
-			uint8_t  node_id;
-			float    temperature;
-			float    humidity;
-			uint16_t adaptive_slices;
-			uint16_t sleep_time;
-			float    battery_level;
-		} payload_packet;
-		uint8_t payload[60];
-	};
+	/**
+	 * Radio payload, holds one frame as described in `WireFormat.h`.
+	 */
+	static uint8_t payload[WireFormat::maxFrameSize];
 }
 
 #endif /* end of include guard: PAYLOAD_PACKET_H_MB9NXB2W */
@@ -0,0 +1,402 @@
+/*
+ * BatchWCMA.h
+ *
+ *  Created on: 2026-10-17
+ *      Author: agent
+ */
+
+#ifndef BATCHWCMA_H_H4QX2NZA
+#define BATCHWCMA_H_H4QX2NZA
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "Configuration.h"
+
+/**
+ * Many independent WCMA nodes advanced in lockstep.
+ *
+ * Computes the same as one `WCMA` object per node, with the same operations
+ * in the same order, so the results are identical. The state is stored as
+ * struct of arrays: for every slot and day the values of all nodes are
+ * contiguous. The inner loops run across the nodes and have no dependencies
+ * between iterations, which lets the compiler vectorise them.
+ *
+ * Since all nodes advance one slot per call, the position within the day,
+ * the head of the matrix ring and the fill level of the samples are the same
+ * for all nodes and are stored once.
+ *
+ * @param Number of slots per day, @f$ N @f$ in the formulas.
+ * @param Number of days retained, @f$ D @f$ in the formulas.
+ * @param Number of samples used for the prediction, @f$ K @f$ in the
+ * formulas.
+ * @param The number type used for the computation.
+ */
+template <const std::size_t N = Configuration::slotsPerDay,
+		  const std::size_t D = Configuration::retainDays,
+		  const std::size_t K = Configuration::retainSamples,
+		  typename T = float>
+class BatchWCMA : public Configuration
+{
+	const std::size_t M;  ///< number of nodes
+
+	std::vector<T> matrix;       ///< @f$ (D+1) \times N \times M @f$, ring of days as in `WCMA`
+	std::vector<T> samples;      ///< @f$ N \times M @f$, the last 24 hours
+	std::vector<T> total;        ///< @f$ M @f$, running sum of `samples`
+	std::vector<T> column_sum;   ///< @f$ N \times M @f$, sum over the past days
+
+	std::vector<T>   energy;     ///< @f$ M @f$, energy of the current slot
+	std::vector<T>   gap_value;  ///< @f$ M @f$
+	std::vector<T>   next;       ///< @f$ M @f$, prediction for the next slot
+	std::vector<T>   average;    ///< @f$ M @f$, average of the last 24 hours
+	std::vector<int> slices;     ///< @f$ M @f$, adaptive slices
+
+	T weight[K];  ///< normalised weights
+
+	unsigned int matrix_head;
+	unsigned int day_index;
+	unsigned int days_since_resync;
+	std::size_t  filled;  ///< samples stored, up to @f$ N @f$
+
+	T* row( const std::size_t day, const std::size_t slot )
+	{
+		return &matrix[( day * N + slot ) * M];
+	}
+
+	/**
+	 * Row of the matrix ring of a past day.
+	 *
+	 * @param age One for yesterday up to @f$ D @f$.
+	 */
+	std::size_t past_day( const std::size_t age ) const
+	{
+		const std::size_t i = matrix_head + age;
+		return i <= D ? i : i - D - 1;
+	}
+
+	/**
+	 * @see WCMA::normalize_weights()
+	 */
+	bool normalize_weights( const float ( &weights )[K] )
+	{
+		float sum = 0;
+
+		for ( std::size_t k = 0; k < K; ++k )
+		{
+			if ( !( weights[k] >= 0 ) )
+				return false;
+
+			sum += weights[k];
+		}
+
+		if ( !( sum > 0 ) || sum > std::numeric_limits<float>::max() )
+			return false;
+
+		for ( std::size_t k = 0; k < K; ++k )
+			weight[k] = from_float<T>( weights[k] / sum );
+
+		return true;
+	}
+
+	void resync_column_sum();
+
+	void reorder_prediction_matrix();
+
+	void update_predictions();
+
+public:
+
+	explicit BatchWCMA( const std::size_t nodes );
+
+	std::size_t size() const
+	{
+		return M;
+	}
+
+	/**
+	 * @see WCMA::setLinearWeights()
+	 */
+	void setLinearWeights()
+	{
+		float weights[K];
+
+		for ( std::size_t k = 0; k < K; ++k )
+			weights[k] = static_cast<float>( k + 1 ) / K;
+
+		normalize_weights( weights );
+	}
+
+	/**
+	 * @see WCMA::setExponentialWeights()
+	 */
+	bool setExponentialWeights( const float base )
+	{
+		float weights[K];
+		float w = 1;
+
+		for ( std::size_t k = K; k; --k )
+			weights[k - 1] = w,
+			w *= base;
+
+		return normalize_weights( weights );
+	}
+
+	/**
+	 * @see WCMA::setWeights()
+	 */
+	bool setWeights( const float ( &weights )[K] )
+	{
+		return normalize_weights( weights );
+	}
+
+	/**
+	 * Fills the energy prediction matrix of every node with its luminance.
+	 *
+	 * @param luminance One value per node.
+	 *
+	 * @see WCMA::initialize()
+	 */
+	void initialize( const float *luminance );
+
+	/**
+	 * Advances all nodes by one slot.
+	 *
+	 * Afterwards the prediction, the adaptive slices and the average are
+	 * those a `WCMA` object has after `calculateAdaptiveSlices()`.
+	 *
+	 * @param luminance The energy of the slot, one value per node.
+	 */
+	void step( const float *luminance );
+
+	/**
+	 * @return @f$ M @f$ predictions for the next slot, see
+	 * `WCMA::nextPrediction()`.
+	 */
+	const T* nextPrediction() const
+	{
+		return &next[0];
+	}
+
+	/**
+	 * @return @f$ M @f$ GAP values, see `WCMA::gap()`.
+	 */
+	const T* gap() const
+	{
+		return &gap_value[0];
+	}
+
+	/**
+	 * @return @f$ M @f$ averages, see `WCMA::last_24h_avg()`.
+	 */
+	const T* last_24h_avg() const
+	{
+		return &average[0];
+	}
+
+	/**
+	 * @return @f$ M @f$ numbers of slices, see `WCMA::adaptive_slices`.
+	 */
+	const int* adaptive_slices() const
+	{
+		return &slices[0];
+	}
+};
+
+
+template <const std::size_t N, const std::size_t D, const std::size_t K, typename T>
+BatchWCMA<N, D, K, T>::BatchWCMA( const std::size_t nodes ) :
+	M          ( nodes ),
+	matrix     ( ( D + 1 ) * N * nodes ),
+	samples    ( N * nodes ),
+	total      ( nodes ),
+	column_sum ( N * nodes ),
+	energy     ( nodes ),
+	gap_value  ( nodes ),
+	next       ( nodes ),
+	average    ( nodes ),
+	slices     ( nodes, 1 ),
+	matrix_head( 0 ),
+	day_index  ( 0 ),
+	days_since_resync( 0 ),
+	filled     ( 0 )
+{
+	setLinearWeights();
+}
+
+
+template <const std::size_t N, const std::size_t D, const std::size_t K, typename T>
+void BatchWCMA<N, D, K, T>::initialize( const float *luminance )
+{
+	for ( std::size_t m = 0; m < M; ++m )
+		energy[m] = from_float<T>( luminance[m] );
+
+	for ( std::size_t d = 0; d <= D; ++d )
+		for ( std::size_t j = 0; j < N; ++j )
+		{
+			T* r = row( d, j );
+
+			for ( std::size_t m = 0; m < M; ++m )
+				r[m] = energy[m];
+		}
+
+	std::fill( samples.begin(), samples.end(), T( 0 ) );
+	std::fill( total.begin(), total.end(), T( 0 ) );
+	filled = 0;
+
+	matrix_head = 0;
+
+	resync_column_sum();
+
+	day_index = 0;
+}
+
+
+template <const std::size_t N, const std::size_t D, const std::size_t K, typename T>
+void BatchWCMA<N, D, K, T>::resync_column_sum()
+{
+	std::fill( column_sum.begin(), column_sum.end(), T( 0 ) );
+
+	for ( std::size_t i = 1; i <= D; ++i )
+		for ( std::size_t j = 0; j < N; ++j )
+		{
+			const T* r = row( past_day( i ), j );
+			T*       c = &column_sum[j * M];
+
+			for ( std::size_t m = 0; m < M; ++m )
+				c[m] += r[m];
+		}
+
+	days_since_resync = 0;
+}
+
+
+template <const std::size_t N, const std::size_t D, const std::size_t K, typename T>
+void BatchWCMA<N, D, K, T>::step( const float *luminance )
+{
+	T* s = &samples[day_index * M];
+	T* r = row( matrix_head, day_index );
+
+	// `current_day_samples.push()` and the write into the matrix
+	for ( std::size_t m = 0; m < M; ++m )
+	{
+		const T e = from_float<T>( luminance[m] );
+
+		total[m] += e - s[m];
+		s[m]      = e;
+		r[m]      = e;
+		energy[m] = e;
+	}
+
+	if ( filled < N )
+		++filled;
+
+	// the running sum is recomputed once per revolution for inexact types
+	if ( day_index == N - 1 && !std::numeric_limits<T>::is_exact )
+	{
+		std::fill( total.begin(), total.end(), T( 0 ) );
+
+		for ( std::size_t j = 0; j < N; ++j )
+		{
+			const T* sj = &samples[j * M];
+
+			for ( std::size_t m = 0; m < M; ++m )
+				total[m] += sj[m];
+		}
+	}
+
+	// `pastDaysQuotient()` and `gap()`, a dot product over the quotients
+	const T reciprocal = NumericPolicy<T>::template reciprocal<D>();
+
+	std::fill( gap_value.begin(), gap_value.end(), T( 0 ) );
+
+	for ( std::size_t i = 0; i < K; ++i )
+	{
+		const std::size_t k = K - 1 - i;
+		const T           w = weight[i];
+
+		if ( k < filled )
+		{
+			const std::size_t index = day_index >= k ? day_index - k : day_index + N - k;
+			const T*          sk    = &samples[index * M];
+			const T*          c     = &column_sum[index * M];
+
+			for ( std::size_t m = 0; m < M; ++m )
+				gap_value[m] = NumericPolicy<T>::mac( gap_value[m], sk[m] / ( c[m] * reciprocal ), w );
+		}
+		else
+			for ( std::size_t m = 0; m < M; ++m )
+				gap_value[m] = NumericPolicy<T>::mac( gap_value[m], T( 1 ), w );
+	}
+
+	// `last_24h_avg()` and the adaptive slices
+	const T storageCycle = numeric_cast<T>( energyPerStorageCycle );
+
+	if ( filled == N )
+		for ( std::size_t m = 0; m < M; ++m )
+			average[m] = total[m] / N;
+	else
+	{
+		std::fill( average.begin(), average.end(), T( 0 ) );
+
+		for ( std::size_t j = 0; j < filled; ++j )
+		{
+			const T* sj = &samples[j * M];
+
+			for ( std::size_t m = 0; m < M; ++m )
+				average[m] += sj[m];
+		}
+
+		for ( std::size_t m = 0; m < M; ++m )
+			average[m] = average[m] / filled;
+	}
+
+	for ( std::size_t m = 0; m < M; ++m )
+	{
+		const int a = NumericPolicy<T>::ceil( ( average[m] - storageCycle ) / storageCycle + 1 );
+		slices[m] = a < 1 ? 1 : a;
+	}
+
+	if ( day_index == N - 1 )
+		reorder_prediction_matrix(),
+		day_index = 0;
+	else
+		++day_index;
+
+	update_predictions();
+}
+
+
+template <const std::size_t N, const std::size_t D, const std::size_t K, typename T>
+void BatchWCMA<N, D, K, T>::update_predictions()
+{
+	const T alpha      = numeric_cast<T>( weightingFactor );
+	const T beta       = 1 - alpha;
+	const T reciprocal = NumericPolicy<T>::template reciprocal<D>();
+	const T* c         = &column_sum[day_index * M];
+
+	for ( std::size_t m = 0; m < M; ++m )
+		next[m] = alpha * energy[m] + gap_value[m] * beta * ( c[m] * reciprocal );
+}
+
+
+template <const std::size_t N, const std::size_t D, const std::size_t K, typename T>
+void BatchWCMA<N, D, K, T>::reorder_prediction_matrix()
+{
+	for ( std::size_t j = 0; j < N; ++j )
+	{
+		const T* today   = row( matrix_head, j );
+		const T* evicted = row( past_day( D ), j );
+		T*       c       = &column_sum[j * M];
+
+		for ( std::size_t m = 0; m < M; ++m )
+			c[m] += today[m] - evicted[m];
+	}
+
+	matrix_head = matrix_head ? matrix_head - 1 : D;
+
+	if ( !std::numeric_limits<T>::is_exact && ++days_since_resync >= D )
+		resync_column_sum();
+}
+
+#endif /* end of include guard: BATCHWCMA_H_H4QX2NZA */
@@ -0,0 +1,65 @@
+/*
+ * Simulation.cpp
+ *
+ *  Created on: 2026-10-17
+ *      Author: agent
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "Simulation.h"
+
+
+Simulation::Simulation( const Trace& t, const Parameters& p ) :
+	trace      ( t ),
+	parameters ( p ),
+	time       ( 0 ),
+	energy     ( .5 * p.capacitance * p.initialVoltage * p.initialVoltage ),
+	maxEnergy  ( .5 * p.capacitance * p.maxVoltage * p.maxVoltage ),
+	emptyEnergy( .5 * p.capacitance * p.emptyVoltage * p.emptyVoltage )
+{
+	stats.wakeups    = 0;
+	stats.missed     = 0;
+	stats.harvested  = 0;
+	stats.consumed   = 0;
+	stats.wasted     = 0;
+	stats.minVoltage = p.initialVoltage;
+}
+
+
+float Simulation::voltage() const
+{
+	return std::sqrt( 2 * energy / parameters.capacitance );
+}
+
+
+void Simulation::sleep( const unsigned int seconds )
+{
+	const unsigned long end = std::min( time + seconds, trace.duration() );
+
+	// the trace is constant within a sample, charge piecewise
+	while ( time < end )
+	{
+		const unsigned long next = std::min( ( time / trace.period() + 1 ) * trace.period(), end );
+		const double        e    = static_cast<double>( trace.at( time ) ) * ( next - time ) / parameters.slotLength;
+
+		stats.harvested += e;
+		energy          += e;
+		time             = next;
+	}
+
+	if ( energy > maxEnergy )
+		stats.wasted += energy - maxEnergy,
+		energy        = maxEnergy;
+
+	++stats.wakeups;
+
+	if ( energy < emptyEnergy + parameters.energyPerWakeup )
+		++stats.missed;
+	else
+		energy         -= parameters.energyPerWakeup,
+		stats.consumed += parameters.energyPerWakeup;
+
+	stats.minVoltage = std::min( stats.minVoltage, voltage() );
+}
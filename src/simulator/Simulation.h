@@ -0,0 +1,127 @@
+/*
+ * Simulation.h
+ *
+ *  Created on: 2026-10-17
+ *      Author: agent
+ */
+
+#ifndef SIMULATION_H_F8RW3KTE
+#define SIMULATION_H_F8RW3KTE
+
+#include "Trace.h"
+
+/**
+ * Virtual clock and energy storage of a simulated sensor node.
+ *
+ * The clock only advances when the node goes to sleep. While it sleeps, the
+ * storage is charged with the energy of the trace. Every wake-up costs a
+ * fixed amount of energy. The storage is a capacitor,
+ * @f$ E=\frac{1}{2}CV^2 @f$.
+ */
+class Simulation
+{
+public:
+
+	struct Parameters
+	{
+		unsigned int slotLength;       ///< value in @f$ s @f$, a trace sample is the energy of one slot
+		float        capacitance;      ///< value in @f$ F @f$
+		float        maxVoltage;       ///< value in @f$ V @f$, surplus energy is lost
+		float        emptyVoltage;     ///< value in @f$ V @f$, the node can not operate below
+		float        initialVoltage;   ///< value in @f$ V @f$
+		float        energyPerWakeup;  ///< value in @f$ J @f$
+	};
+
+	/**
+	 * Results of a simulation run.
+	 */
+	struct Statistics
+	{
+		unsigned long wakeups;
+		unsigned long missed;        ///< wake-ups with an empty storage
+		double        harvested;     ///< value in @f$ J @f$
+		double        consumed;      ///< value in @f$ J @f$
+		double        wasted;        ///< value in @f$ J @f$, lost at a full storage
+		float         minVoltage;    ///< value in @f$ V @f$
+	};
+
+	Simulation( const Trace& t, const Parameters& p );
+
+	unsigned long now() const
+	{
+		return time;
+	}
+
+	bool finished() const
+	{
+		return time >= trace.duration();
+	}
+
+	float luminance() const
+	{
+		return trace.at( time );
+	}
+
+	float voltage() const;
+
+	/**
+	 * Sleeps and wakes up again.
+	 *
+	 * Charges the storage for the time slept and takes the energy of the
+	 * wake-up from it.
+	 *
+	 * @param seconds The sleep time in @f$ s @f$.
+	 */
+	void sleep( const unsigned int seconds );
+
+	const Statistics& statistics() const
+	{
+		return stats;
+	}
+
+private:
+
+	const Trace&     trace;
+	const Parameters parameters;
+
+	unsigned long time;    ///< value in @f$ s @f$
+	double        energy;  ///< stored energy in @f$ J @f$
+	double        maxEnergy;
+	double        emptyEnergy;
+
+	Statistics stats;
+};
+
+
+/**
+ * Platform of the algorithms in the simulator, see `Platform.h`.
+ */
+class SimulatedPlatform
+{
+	Simulation *simulation;
+
+public:
+
+	explicit SimulatedPlatform( Simulation *s = 0 ) : simulation( s ) {}
+
+	float getLuminance()
+	{
+		return simulation->luminance();
+	}
+
+	float getStorageVoltage()
+	{
+		return simulation->voltage();
+	}
+
+	void resetClock()
+	{
+	}
+
+	void sleep( const unsigned int seconds )
+	{
+		simulation->sleep( seconds );
+	}
+};
+
+#endif /* end of include guard: SIMULATION_H_F8RW3KTE */
@@ -0,0 +1,84 @@
+/*
+ * Trace.cpp
+ *
+ *  Created on: 2026-10-17
+ *      Author: agent
+ */
+
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <stdint.h>
+#include <cstring>
+
+#include "Trace.h"
+
+
+bool Trace::load_csv( const std::string& path )
+{
+	std::ifstream file( path.c_str() );
+
+	if ( !file )
+		return false;
+
+	std::string line;
+
+	while ( std::getline( file, line ) )
+	{
+		if ( line.empty() || line[0] == '#' )
+			continue;
+
+		const std::size_t comma = line.rfind( ',' );
+		const char *field       = line.c_str() + ( comma == std::string::npos ? 0 : comma + 1 );
+		char *end;
+
+		const float value = std::strtof( field, &end );
+
+		if ( end != field )
+			samples.push_back( value );
+	}
+
+	return true;
+}
+
+
+bool Trace::load_binary( const std::string& path )
+{
+	std::ifstream file( path.c_str(), std::ios::binary );
+
+	if ( !file )
+		return false;
+
+	uint8_t bytes[4];
+
+	while ( file.read( reinterpret_cast<char*>( bytes ), sizeof( bytes ) ) )
+	{
+		const uint32_t raw = bytes[0] | bytes[1] << 8 | bytes[2] << 16 | static_cast<uint32_t>( bytes[3] ) << 24;
+		float value;
+
+		std::memcpy( &value, &raw, sizeof( value ) );
+		samples.push_back( value );
+	}
+
+	return true;
+}
+
+
+void Trace::synthetic( const std::size_t days, const float peak )
+{
+	const std::size_t slots = 86400 / interval;
+
+	std::srand( 1 );
+
+	for ( std::size_t d = 0; d < days; ++d )
+	{
+		const float cloud = .2 + .8 * std::rand() / RAND_MAX;
+
+		for ( std::size_t s = 0; s < slots; ++s )
+		{
+			const float hour = 24. * s / slots;
+			const float sun  = std::sin( M_PI * ( hour - 6 ) / 12 );
+			samples.push_back( sun > 0 ? peak * cloud * sun : 0 );
+		}
+	}
+}
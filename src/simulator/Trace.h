@@ -0,0 +1,98 @@
+/*
+ * Trace.h
+ *
+ *  Created on: 2026-10-17
+ *      Author: agent
+ */
+
+#ifndef TRACE_H_M2VD7HXS
+#define TRACE_H_M2VD7HXS
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * A recorded solar trace.
+ *
+ * The trace holds luminance values, in the unit returned by
+ * `Algorithms::getLuminance()`, sampled at a fixed interval. Between two
+ * samples the value is held constant.
+ */
+class Trace
+{
+	std::vector<float> samples;
+	unsigned int       interval;  ///< value in @f$ s @f$
+
+public:
+
+	explicit Trace( const unsigned int i ) : interval( i ) {}
+
+	/**
+	 * Reads a text trace.
+	 *
+	 * One sample per line. If a line has several comma-separated fields,
+	 * the last one is used, so a leading timestamp column is ignored. Empty
+	 * lines and lines starting with `#` are skipped.
+	 *
+	 * @return `false` if the file can not be opened.
+	 */
+	bool load_csv( const std::string& path );
+
+	/**
+	 * Reads a binary trace of 32 bit little-endian floats.
+	 *
+	 * @return `false` if the file can not be opened.
+	 */
+	bool load_binary( const std::string& path );
+
+	/**
+	 * Generates a synthetic trace.
+	 *
+	 * A half sine per day from 6 to 18 o'clock, scaled by a random cloud
+	 * factor per day. The sequence is the same on every call.
+	 *
+	 * @param days Length of the trace in days.
+	 * @param peak Luminance at noon on a clear day.
+	 */
+	void synthetic( const std::size_t days, const float peak );
+
+	bool empty() const
+	{
+		return samples.empty();
+	}
+
+	std::size_t size() const
+	{
+		return samples.size();
+	}
+
+	/**
+	 * @return The sample interval in @f$ s @f$.
+	 */
+	unsigned int period() const
+	{
+		return interval;
+	}
+
+	/**
+	 * @return The length of the trace in @f$ s @f$.
+	 */
+	unsigned long duration() const
+	{
+		return static_cast<unsigned long>( samples.size() ) * interval;
+	}
+
+	/**
+	 * The luminance at a point in time.
+	 *
+	 * @param t Time in @f$ s @f$ since the start of the trace, less than
+	 * `duration()`.
+	 */
+	float at( const unsigned long t ) const
+	{
+		return samples[t / interval];
+	}
+};
+
+#endif /* end of include guard: TRACE_H_M2VD7HXS */
@@ -0,0 +1,212 @@
+/*
+ * simulator.cpp
+ *
+ * Replays a solar trace through the EWMA or WCMA predictor on the host. The
+ * predictors are the unmodified firmware code, only the platform is
+ * replaced by a virtual clock and a model of the energy storage.
+ *
+ *  Created on: 2026-10-17
+ *      Author: agent
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+
+#include "EWMA.h"
+#include "WCMA.h"
+#include "Simulation.h"
+
+struct Options
+{
+	std::string algorithm;
+	int         fractionBits;
+	float       weightingFactor;
+	float       energyPerStorageCycle;
+};
+
+
+/**
+ * Runs the predictor until the trace is exhausted.
+ */
+template <typename Predictor>
+void simulate( Simulation& simulation, const Options& options )
+{
+	Predictor predictor( ( SimulatedPlatform( &simulation ) ) );
+
+	predictor.weightingFactor       = numeric_t( options.weightingFactor );
+	predictor.energyPerStorageCycle = numeric_t( options.energyPerStorageCycle );
+
+	predictor.initialize();
+
+	while ( !simulation.finished() )
+		predictor.do_all_the_magic();
+}
+
+
+template <typename T>
+void run( Simulation& simulation, const Options& options )
+{
+	if ( options.algorithm == "ewma" )
+		simulate< EWMA<Configuration::slotsPerDay, T, SimulatedPlatform> >( simulation, options );
+	else
+		simulate< WCMA<Configuration::slotsPerDay, Configuration::retainDays, Configuration::retainSamples, T, SimulatedPlatform> >( simulation, options );
+}
+
+
+void usage( const char *name )
+{
+	std::cerr
+		<< "usage: " << name << " [options] [trace]" << std::endl
+		<< "  -a ewma|wcma  predictor, default wcma" << std::endl
+		<< "  -q bits       fractional bits of fixed-point numbers, 0 for float" << std::endl
+		<< "  -w alpha      weightingFactor" << std::endl
+		<< "  -e joule      energyPerStorageCycle, the energy of one wake-up" << std::endl
+		<< "  -i seconds    sample interval of the trace, default one slot" << std::endl
+		<< "  -b            binary trace of little-endian floats instead of text" << std::endl
+		<< "  -c farad      capacitance of the energy storage" << std::endl
+		<< "  -v volt       initial storage voltage" << std::endl
+		<< "  -d days       length of the synthetic trace used without a file" << std::endl
+		<< "  -p peak       peak of the synthetic trace" << std::endl;
+}
+
+
+int main( int argc, char *argv[] )
+{
+	const Configuration defaults;
+
+	Options options;
+	options.algorithm             = "wcma";
+	options.fractionBits          = 0;
+	options.weightingFactor       = to_float( defaults.weightingFactor );
+	options.energyPerStorageCycle = to_float( defaults.energyPerStorageCycle );
+
+	Simulation::Parameters parameters;
+	parameters.slotLength      = Configuration::secondsPerDay / Configuration::slotsPerDay;
+	parameters.capacitance     = 1;
+	parameters.maxVoltage      = to_float( Configuration::energyStorageFull );
+	parameters.emptyVoltage    = to_float( Configuration::energyStorageEmpty );
+	parameters.initialVoltage  = parameters.maxVoltage;
+
+	unsigned int interval = parameters.slotLength;
+	bool         binary   = false;
+	std::size_t  days     = 365;
+	float        peak     = 2;
+	int          opt;
+
+	while ( ( opt = getopt( argc, argv, "a:q:w:e:i:bc:v:d:p:" ) ) != -1 )
+		switch ( opt )
+		{
+		case 'a':
+			options.algorithm = optarg;
+			break;
+
+		case 'q':
+			options.fractionBits = std::atoi( optarg );
+			break;
+
+		case 'w':
+			options.weightingFactor = std::atof( optarg );
+			break;
+
+		case 'e':
+			options.energyPerStorageCycle = std::atof( optarg );
+			break;
+
+		case 'i':
+			interval = std::atoi( optarg );
+			break;
+
+		case 'b':
+			binary = true;
+			break;
+
+		case 'c':
+			parameters.capacitance = std::atof( optarg );
+			break;
+
+		case 'v':
+			parameters.initialVoltage = std::atof( optarg );
+			break;
+
+		case 'd':
+			days = std::atoi( optarg );
+			break;
+
+		case 'p':
+			peak = std::atof( optarg );
+			break;
+
+		default:
+			usage( argv[0] );
+			return EXIT_FAILURE;
+		}
+
+	if ( ( options.algorithm != "ewma" && options.algorithm != "wcma" ) || !interval
+		|| ( options.fractionBits != 0 && options.fractionBits != 16 && options.fractionBits != 24 ) )
+	{
+		usage( argv[0] );
+		return EXIT_FAILURE;
+	}
+
+	parameters.energyPerWakeup = options.energyPerStorageCycle;
+
+	Trace trace( interval );
+
+	if ( optind < argc )
+	{
+		if ( !( binary ? trace.load_binary( argv[optind] ) : trace.load_csv( argv[optind] ) ) )
+		{
+			std::cerr << "can not open " << argv[optind] << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+	else
+		trace.synthetic( days, peak );
+
+	if ( trace.empty() )
+	{
+		std::cerr << "empty trace" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	Simulation simulation( trace, parameters );
+
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	switch ( options.fractionBits )
+	{
+	case 16:
+		run<q16_16_t>( simulation, options );
+		break;
+
+	case 24:
+		run<q8_24_t>( simulation, options );
+		break;
+
+	default:
+		run<float>( simulation, options );
+	}
+
+	const double elapsed = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+
+	const Simulation::Statistics& stats = simulation.statistics();
+	const double slots = static_cast<double>( trace.duration() ) / parameters.slotLength;
+
+	std::cout
+		<< "slots          " << slots                              << std::endl
+		<< "wake-ups       " << stats.wakeups                      << std::endl
+		<< "slices/slot    " << stats.wakeups / slots              << std::endl
+		<< "missed         " << stats.missed                       << std::endl
+		<< "harvested      " << stats.harvested                    << " J" << std::endl
+		<< "consumed       " << stats.consumed                     << " J" << std::endl
+		<< "wasted         " << stats.wasted                       << " J" << std::endl
+		<< "min voltage    " << stats.minVoltage                   << " V" << std::endl
+		<< "final voltage  " << simulation.voltage()               << " V" << std::endl
+		<< "run time       " << elapsed                            << " s" << std::endl
+		<< "slots/s        " << ( elapsed > 0 ? slots / elapsed : 0 ) << std::endl;
+
+	return EXIT_SUCCESS;
+}
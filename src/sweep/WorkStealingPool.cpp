@@ -0,0 +1,80 @@
+/*
+ * WorkStealingPool.cpp
+ *
+ *  Created on: 2026-10-17
+ *      Author: agent
+ */
+
+#include <thread>
+
+#include "WorkStealingPool.h"
+
+
+WorkStealingPool::WorkStealingPool( const unsigned int threads ) :
+	workers( threads ? threads : std::thread::hardware_concurrency() )
+{
+	if ( !workers )
+		workers = 1;
+}
+
+
+void WorkStealingPool::run( const std::size_t n, const task_t& task )
+{
+	std::vector<Queue> queues( workers );
+
+	// contiguous ranges, neighbouring tasks tend to cost the same
+	for ( unsigned int w = 0; w < workers; ++w )
+		for ( std::size_t i = n * w / workers; i < n * ( w + 1 ) / workers; ++i )
+			queues[w].tasks.push_back( i );
+
+	std::vector<std::thread> threads;
+
+	for ( unsigned int w = 1; w < workers; ++w )
+		threads.push_back( std::thread( &WorkStealingPool::work, this, std::ref( queues ), w, std::cref( task ) ) );
+
+	work( queues, 0, task );
+
+	for ( std::size_t t = 0; t < threads.size(); ++t )
+		threads[t].join();
+}
+
+
+bool WorkStealingPool::next( std::vector<Queue>& queues, const unsigned int worker, std::size_t& task )
+{
+	{
+		Queue& own = queues[worker];
+		std::lock_guard<std::mutex> lock( own.mutex );
+
+		if ( !own.tasks.empty() )
+		{
+			task = own.tasks.back();
+			own.tasks.pop_back();
+			return true;
+		}
+	}
+
+	for ( unsigned int v = 1; v < workers; ++v )
+	{
+		Queue& victim = queues[( worker + v ) % workers];
+		std::lock_guard<std::mutex> lock( victim.mutex );
+
+		if ( !victim.tasks.empty() )
+		{
+			task = victim.tasks.front();
+			victim.tasks.pop_front();
+			return true;
+		}
+	}
+
+	// no tasks are added while running, so all work is handed out
+	return false;
+}
+
+
+void WorkStealingPool::work( std::vector<Queue>& queues, const unsigned int worker, const task_t& task )
+{
+	std::size_t i;
+
+	while ( next( queues, worker, i ) )
+		task( i );
+}
@@ -0,0 +1,69 @@
+/*
+ * WorkStealingPool.h
+ *
+ *  Created on: 2026-10-17
+ *      Author: agent
+ */
+
+#ifndef WORKSTEALINGPOOL_H_C6TN1WQB
+#define WORKSTEALINGPOOL_H_C6TN1WQB
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+/**
+ * Runs a fixed number of independent tasks on all cores.
+ *
+ * Every worker owns a queue with a contiguous range of the tasks and takes
+ * them from the back. A worker whose queue has run dry steals from the
+ * front of the other queues, so workers that got the cheap tasks help the
+ * ones that got the expensive ones.
+ */
+class WorkStealingPool
+{
+public:
+
+	typedef std::function<void( std::size_t )> task_t;
+
+	/**
+	 * @param threads Number of workers, zero for one per core.
+	 */
+	explicit WorkStealingPool( unsigned int threads = 0 );
+
+	unsigned int size() const
+	{
+		return workers;
+	}
+
+	/**
+	 * Calls `task( i )` for all @f$ i @f$ from zero up to @f$ n @f$.
+	 *
+	 * Returns when all tasks are done. The tasks must not depend on each
+	 * other, they run in no particular order.
+	 */
+	void run( const std::size_t n, const task_t& task );
+
+private:
+
+	struct Queue
+	{
+		std::mutex              mutex;
+		std::deque<std::size_t> tasks;
+	};
+
+	unsigned int workers;
+
+	/**
+	 * Takes the next task of a worker, from its own queue or another one.
+	 *
+	 * @return `false` if all queues are empty.
+	 */
+	bool next( std::vector<Queue>& queues, const unsigned int worker, std::size_t& task );
+
+	void work( std::vector<Queue>& queues, const unsigned int worker, const task_t& task );
+};
+
+#endif /* end of include guard: WORKSTEALINGPOOL_H_C6TN1WQB */
@@ -0,0 +1,465 @@
+/*
+ * sweep.cpp
+ *
+ * Evaluates WCMA and EWMA for every combination of the parameters given on
+ * the command line by replaying a solar trace through the simulator, and
+ * prints the configurations ranked by their score.
+ *
+ *  Created on: 2026-10-17
+ *      Author: agent
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+#include "EWMA.h"
+#include "WCMA.h"
+#include "Simulation.h"
+#include "WorkStealingPool.h"
+
+const std::size_t maxDays    = 8;  ///< largest `retainDays` that can be swept
+const std::size_t maxSamples = 8;  ///< largest `retainSamples` that can be swept
+
+enum Algorithm { wcma, ewma };
+
+/**
+ * One configuration and its score.
+ */
+struct Result
+{
+	Algorithm     algorithm;
+	float         weightingFactor;
+	float         energyPerStorageCycle;
+	std::size_t   retainDays;     ///< WCMA only
+	std::size_t   retainSamples;  ///< WCMA only
+
+	double        mae;      ///< mean absolute error of the prediction of the next slot
+	unsigned long invalid;  ///< predictions that are not finite, e.g. 0/0 at night
+	unsigned long missed;   ///< wake-ups with an empty storage
+	unsigned long samples;  ///< wake-ups, each takes a sample
+};
+
+typedef void ( *evaluator_t )( const Trace&, const Simulation::Parameters&, Result& );
+
+
+/**
+ * Runs a predictor over the trace.
+ */
+template <typename Predictor>
+void replay( const Trace& trace, const Simulation::Parameters& parameters, Result& result )
+{
+	Simulation::Parameters p = parameters;
+	p.energyPerWakeup        = result.energyPerStorageCycle;
+
+	Simulation simulation( trace, p );
+
+	Predictor predictor( ( SimulatedPlatform( &simulation ) ) );
+
+	predictor.weightingFactor       = numeric_t( result.weightingFactor );
+	predictor.energyPerStorageCycle = numeric_t( result.energyPerStorageCycle );
+
+	predictor.initialize();
+
+	double        error       = 0;
+	unsigned long predictions = 0;
+	float         predicted   = 0;
+	bool          valid       = false;
+
+	while ( !simulation.finished() )
+	{
+		const float energy = predictor.do_all_the_magic();
+
+		// only the first slice of a slot computes a prediction
+		if ( predictor.currentSlice() )
+			continue;
+
+		if ( valid )
+			error += std::fabs( energy - predicted ),
+			++predictions;
+
+		predicted = to_float( predictor.nextPrediction() );
+		valid     = std::isfinite( predicted );
+
+		if ( !valid )
+			++result.invalid;
+	}
+
+	result.mae     = predictions ? error / predictions : 0;
+	result.missed  = simulation.statistics().missed;
+	result.samples = simulation.statistics().wakeups;
+}
+
+
+/**
+ * Runs WCMA with @f$ D @f$ days and @f$ K @f$ samples over the trace.
+ */
+template <const std::size_t D, const std::size_t K>
+void evaluate( const Trace& trace, const Simulation::Parameters& parameters, Result& result )
+{
+	replay< WCMA<Configuration::slotsPerDay, D, K, float, SimulatedPlatform> >( trace, parameters, result );
+}
+
+
+/**
+ * Table of the `evaluate()` instantiations, indexed by @f$ D-1 @f$ and
+ * @f$ K-1 @f$.
+ */
+template <const std::size_t D, const std::size_t K> struct Evaluators
+{
+	static void fill( evaluator_t ( &table )[maxDays][maxSamples] )
+	{
+		table[D - 1][K - 1] = evaluate<D, K>;
+		Evaluators<D, K - 1>::fill( table );
+	}
+};
+
+template <const std::size_t D> struct Evaluators<D, 0>
+{
+	static void fill( evaluator_t ( &table )[maxDays][maxSamples] )
+	{
+		Evaluators<D - 1, maxSamples>::fill( table );
+	}
+};
+
+template <> struct Evaluators<0, maxSamples>
+{
+	static void fill( evaluator_t ( & )[maxDays][maxSamples] )
+	{
+	}
+};
+
+
+/**
+ * Parses a list of values.
+ *
+ * Either comma-separated values, e.g. `1,2,4`, or a range `start:stop:step`
+ * including both ends, the step defaults to one.
+ */
+std::vector<float> parse( const std::string& s )
+{
+	std::vector<float> values;
+
+	if ( s.find( ':' ) != std::string::npos )
+	{
+		float start = 0, stop = 0, step = 1;
+		char  colon;
+		std::istringstream in( s );
+
+		in >> start >> colon >> stop;
+		if ( in >> colon )
+			in >> step;
+
+		if ( step > 0 )
+			for ( long i = 0; i <= std::floor( ( stop - start ) / step + .5 ); ++i )
+				values.push_back( start + i * step );
+	}
+	else
+	{
+		std::istringstream in( s );
+		std::string        field;
+
+		while ( std::getline( in, field, ',' ) )
+			values.push_back( std::atof( field.c_str() ) );
+	}
+
+	return values;
+}
+
+
+/**
+ * Checks a list of sizes, e.g. of `retainDays`.
+ *
+ * @return Whether all values are whole numbers from one up to `max`.
+ */
+bool valid_sizes( const std::vector<float>& values, const std::size_t max )
+{
+	for ( std::size_t i = 0; i < values.size(); ++i )
+		if ( !( values[i] >= 1 ) || values[i] > max || values[i] > std::floor( values[i] ) )
+			return false;
+
+	return true;
+}
+
+
+/**
+ * Order of the results, best first.
+ *
+ * The key selected on the command line decides, ties are broken by the
+ * others: fewer missed wake-ups, lower error, more samples.
+ */
+struct Ranking
+{
+	char key;
+
+	bool operator()( const Result& a, const Result& b ) const
+	{
+		switch ( key )
+		{
+		case 'e':
+			if ( a.mae < b.mae || b.mae < a.mae )
+				return a.mae < b.mae;
+			break;
+
+		case 's':
+			if ( a.samples != b.samples )
+				return a.samples > b.samples;
+			break;
+
+		default:
+			break;
+		}
+
+		if ( a.missed != b.missed )
+			return a.missed < b.missed;
+
+		if ( a.mae < b.mae || b.mae < a.mae )
+			return a.mae < b.mae;
+
+		return a.samples > b.samples;
+	}
+};
+
+
+void usage( const char *name )
+{
+	std::cerr
+		<< "usage: " << name << " [options] [trace]" << std::endl
+		<< "  -a list     algorithms, wcma and ewma, default both" << std::endl
+		<< "  -w list     weightingFactor, default 0.1:0.9:0.1" << std::endl
+		<< "  -e list     energyPerStorageCycle in joule, default 0.01:0.1:0.01" << std::endl
+		<< "  -D list     retainDays of WCMA, whole numbers up to " << maxDays << ", default 1:" << maxDays << std::endl
+		<< "  -K list     retainSamples of WCMA, whole numbers up to " << maxSamples << ", default 1:6" << std::endl
+		<< "  -r key      rank by missed wake-ups (m), error (e) or samples (s)" << std::endl
+		<< "  -n rows     number of configurations printed, default 20" << std::endl
+		<< "  -t threads  default one per core" << std::endl
+		<< "  -i seconds  sample interval of the trace, default one slot" << std::endl
+		<< "  -b          binary trace of little-endian floats instead of text" << std::endl
+		<< "  -c farad    capacitance of the energy storage" << std::endl
+		<< "  -d days     length of the synthetic trace used without a file" << std::endl
+		<< "  -p peak     peak of the synthetic trace" << std::endl
+		<< "A list of numbers is either comma-separated values or a range start:stop:step." << std::endl;
+}
+
+
+int main( int argc, char *argv[] )
+{
+	std::vector<float> alphas  = parse( "0.1:0.9:0.1" );
+	std::vector<float> cycles  = parse( "0.01:0.1:0.01" );
+	std::vector<float> days    = parse( "1:8" );
+	std::vector<float> samples = parse( "1:6" );
+	bool               run[2]  = { true, true };  // by `Algorithm`
+
+	Simulation::Parameters parameters;
+	parameters.slotLength     = Configuration::secondsPerDay / Configuration::slotsPerDay;
+	parameters.capacitance    = 1;
+	parameters.maxVoltage     = to_float( Configuration::energyStorageFull );
+	parameters.emptyVoltage   = to_float( Configuration::energyStorageEmpty );
+	parameters.initialVoltage = parameters.maxVoltage;
+
+	Ranking      ranking  = { 'm' };
+	std::size_t  rows     = 20;
+	unsigned int threads  = 0;
+	unsigned int interval = parameters.slotLength;
+	bool         binary   = false;
+	std::size_t  length   = 365;
+	float        peak     = 2;
+	int          opt;
+
+	while ( ( opt = getopt( argc, argv, "a:w:e:D:K:r:n:t:i:bc:d:p:" ) ) != -1 )
+		switch ( opt )
+		{
+		case 'a':
+		{
+			std::istringstream in( optarg );
+			std::string        name;
+
+			run[wcma] = run[ewma] = false;
+
+			while ( std::getline( in, name, ',' ) )
+				if ( name == "wcma" )
+					run[wcma] = true;
+				else if ( name == "ewma" )
+					run[ewma] = true;
+				else
+					return usage( argv[0] ), EXIT_FAILURE;
+			break;
+		}
+
+		case 'w':
+			alphas = parse( optarg );
+			break;
+
+		case 'e':
+			cycles = parse( optarg );
+			break;
+
+		case 'D':
+			days = parse( optarg );
+			break;
+
+		case 'K':
+			samples = parse( optarg );
+			break;
+
+		case 'r':
+			if ( std::string( optarg ) != "m" && std::string( optarg ) != "e" && std::string( optarg ) != "s" )
+				return usage( argv[0] ), EXIT_FAILURE;
+
+			ranking.key = optarg[0];
+			break;
+
+		case 'n':
+			rows = std::atoi( optarg );
+			break;
+
+		case 't':
+			threads = std::atoi( optarg );
+			break;
+
+		case 'i':
+			interval = std::atoi( optarg );
+			break;
+
+		case 'b':
+			binary = true;
+			break;
+
+		case 'd':
+			length = std::atoi( optarg );
+			break;
+
+		case 'p':
+			peak = std::atof( optarg );
+			break;
+
+		case 'c':
+			parameters.capacitance = std::atof( optarg );
+			break;
+
+		default:
+			usage( argv[0] );
+			return EXIT_FAILURE;
+		}
+
+	if ( !valid_sizes( days, maxDays ) || !valid_sizes( samples, maxSamples ) )
+		return usage( argv[0] ), EXIT_FAILURE;
+
+	if ( !interval || !( run[wcma] || run[ewma] ) )
+		return usage( argv[0] ), EXIT_FAILURE;
+
+	Trace trace( interval );
+
+	if ( optind < argc )
+	{
+		if ( !( binary ? trace.load_binary( argv[optind] ) : trace.load_csv( argv[optind] ) ) )
+		{
+			std::cerr << "can not open " << argv[optind] << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+	else
+		trace.synthetic( length, peak );
+
+	if ( trace.empty() )
+	{
+		std::cerr << "empty trace" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	evaluator_t evaluators[maxDays][maxSamples];
+	Evaluators<maxDays, maxSamples>::fill( evaluators );
+
+	// the Cartesian product of all parameters
+	std::vector<Result> results;
+
+	if ( run[wcma] )
+		for ( std::size_t d = 0; d < days.size(); ++d )
+			for ( std::size_t k = 0; k < samples.size(); ++k )
+				for ( std::size_t w = 0; w < alphas.size(); ++w )
+					for ( std::size_t e = 0; e < cycles.size(); ++e )
+					{
+						Result r = Result();
+						r.algorithm             = wcma;
+						r.retainDays            = days[d];
+						r.retainSamples         = samples[k];
+						r.weightingFactor       = alphas[w];
+						r.energyPerStorageCycle = cycles[e];
+						results.push_back( r );
+					}
+
+	// the dimensions of WCMA do not apply
+	if ( run[ewma] )
+		for ( std::size_t w = 0; w < alphas.size(); ++w )
+			for ( std::size_t e = 0; e < cycles.size(); ++e )
+			{
+				Result r = Result();
+				r.algorithm             = ewma;
+				r.weightingFactor       = alphas[w];
+				r.energyPerStorageCycle = cycles[e];
+				results.push_back( r );
+			}
+
+	WorkStealingPool pool( threads );
+
+	std::cerr << "Evaluating " << results.size() << " configurations over "
+		<< trace.duration() / parameters.slotLength << " slots on "
+		<< pool.size() << " threads" << std::endl;
+
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	pool.run( results.size(), [&]( const std::size_t i )
+	{
+		Result& r = results[i];
+
+		if ( r.algorithm == ewma )
+			replay< EWMA<Configuration::slotsPerDay, float, SimulatedPlatform> >( trace, parameters, r );
+		else
+			evaluators[r.retainDays - 1][r.retainSamples - 1]( trace, parameters, r );
+	} );
+
+	const double elapsed = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+
+	std::cerr << "Finished in " << elapsed << " s" << std::endl << std::endl;
+
+	rows = std::min( rows, results.size() );
+	std::partial_sort( results.begin(), results.begin() + rows, results.end(), ranking );
+
+	std::cout
+		<< std::setw( 6 )  << "rank"
+		<< std::setw( 6 )  << "algo"
+		<< std::setw( 8 )  << "alpha"
+		<< std::setw( 10 ) << "E_cycle"
+		<< std::setw( 4 )  << "D"
+		<< std::setw( 4 )  << "K"
+		<< std::setw( 12 ) << "MAE"
+		<< std::setw( 9 )  << "invalid"
+		<< std::setw( 10 ) << "missed"
+		<< std::setw( 10 ) << "samples" << std::endl;
+
+	for ( std::size_t i = 0; i < rows; ++i )
+	{
+		const bool is_wcma = results[i].algorithm == wcma;
+
+		std::cout
+			<< std::setw( 6 )  << i + 1
+			<< std::setw( 6 )  << ( is_wcma ? "wcma" : "ewma" )
+			<< std::setw( 8 )  << results[i].weightingFactor
+			<< std::setw( 10 ) << results[i].energyPerStorageCycle
+			<< std::setw( 4 )  << ( is_wcma ? std::to_string( results[i].retainDays ) : "-" )
+			<< std::setw( 4 )  << ( is_wcma ? std::to_string( results[i].retainSamples ) : "-" )
+			<< std::setw( 12 ) << results[i].mae
+			<< std::setw( 9 )  << results[i].invalid
+			<< std::setw( 10 ) << results[i].missed
+			<< std::setw( 10 ) << results[i].samples << std::endl;
+	}
+
+	return EXIT_SUCCESS;
+}
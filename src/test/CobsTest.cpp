@@ -0,0 +1,121 @@
+/*
+ * CobsTest.cpp
+ *
+ *  Created on: 2026-10-17
+ *      Author: agent
+ */
+
+#include <cstring>
+#include <vector>
+
+#include "Cobs.h"
+#include "Test.h"
+
+namespace
+{
+	bool encodesTo( const std::vector<uint8_t>& in, const std::vector<uint8_t>& expected )
+	{
+		std::vector<uint8_t> out( Cobs::maxEncodedSize( in.size() ) );
+
+		const std::size_t n = Cobs::encode( in.data(), in.size(), out.data() );
+
+		return n == expected.size() && !std::memcmp( out.data(), expected.data(), n );
+	}
+
+	/**
+	 * Encodes and decodes a block.
+	 *
+	 * @return Whether it came back unchanged and the encoded block holds no
+	 * zero.
+	 */
+	bool roundTrip( const std::vector<uint8_t>& in )
+	{
+		std::vector<uint8_t> encoded( Cobs::maxEncodedSize( in.size() ) );
+		std::vector<uint8_t> decoded( encoded.size() );
+
+		const std::size_t n = Cobs::encode( in.data(), in.size(), encoded.data() );
+
+		if ( n > encoded.size() || std::memchr( encoded.data(), 0, n ) )
+			return false;
+
+		const std::size_t m = Cobs::decode( encoded.data(), n, decoded.data() );
+
+		return m == in.size() && !std::memcmp( decoded.data(), in.data(), m );
+	}
+
+	std::vector<uint8_t> block( const std::size_t size, const uint8_t zeroEvery )
+	{
+		std::vector<uint8_t> b( size );
+
+		for ( std::size_t i = 0; i < size; ++i )
+			b[i] = zeroEvery && i % zeroEvery == 0 ? 0 : static_cast<uint8_t>( i * 37 + 1 ) | 1;
+
+		return b;
+	}
+}
+
+
+TEST( cobs_known_blocks )
+{
+	CHECK( encodesTo( { 0x00 }, { 0x01, 0x01 } ) );
+	CHECK( encodesTo( { 0x00, 0x00 }, { 0x01, 0x01, 0x01 } ) );
+	CHECK( encodesTo( { 0x11, 0x22, 0x00, 0x33 }, { 0x03, 0x11, 0x22, 0x02, 0x33 } ) );
+	CHECK( encodesTo( { 0x11, 0x22, 0x33, 0x44 }, { 0x05, 0x11, 0x22, 0x33, 0x44 } ) );
+	CHECK( encodesTo( { 0x11, 0x00, 0x00, 0x00 }, { 0x02, 0x11, 0x01, 0x01, 0x01 } ) );
+	CHECK( encodesTo( {}, { 0x01 } ) );
+}
+
+
+TEST( cobs_round_trip )
+{
+	const std::size_t sizes[] = { 1, 2, 60, 62, 253, 254, 255, 508, 509, 1000 };
+
+	for ( const std::size_t size : sizes )
+	{
+		CHECK( roundTrip( block( size, 0 ) ) );
+		CHECK( roundTrip( block( size, 1 ) ) );
+		CHECK( roundTrip( block( size, 7 ) ) );
+		CHECK( roundTrip( block( size, 254 ) ) );
+		CHECK( roundTrip( block( size, 255 ) ) );
+	}
+}
+
+
+TEST( cobs_overhead )
+{
+	// a run of 254 bytes without a zero takes a code byte of its own
+	for ( std::size_t size = 1; size <= 1000; ++size )
+	{
+		const std::vector<uint8_t> in = block( size, 0 );
+		std::vector<uint8_t>       out( Cobs::maxEncodedSize( size ) );
+
+		if ( Cobs::encode( in.data(), size, out.data() ) > Cobs::maxEncodedSize( size ) )
+		{
+			CHECK( false );
+			break;
+		}
+	}
+}
+
+
+TEST( cobs_invalid_blocks )
+{
+	uint8_t out[16];
+
+	// a zero inside the block
+	const uint8_t zero[] = { 0x03, 0x11, 0x00, 0x02, 0x33 };
+	CHECK( Cobs::decode( zero, sizeof( zero ), out ) == 0 );
+
+	const uint8_t leading[] = { 0x00, 0x11 };
+	CHECK( Cobs::decode( leading, sizeof( leading ), out ) == 0 );
+
+	// a run beyond the end of the block
+	const uint8_t cut[] = { 0x05, 0x11, 0x22 };
+	CHECK( Cobs::decode( cut, sizeof( cut ), out ) == 0 );
+
+	// text printed by the controller
+	const char    *text = "Packet received\r\n";
+	const uint8_t *t    = reinterpret_cast<const uint8_t*>( text );
+	std::vector<uint8_t> decoded( std::strlen( text ) );
+	CHECK( Cobs::decode( t, std::strlen( text ), decoded.data() ) == 0 );
+}
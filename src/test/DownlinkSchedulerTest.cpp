@@ -0,0 +1,183 @@
+/*
+ * DownlinkSchedulerTest.cpp
+ *
+ *  Created on: 2026-10-17
+ *      Author: agent
+ */
+
+#include "DownlinkScheduler.h"
+#include "Test.h"
+
+namespace
+{
+	typedef DownlinkScheduler::Clock Clock;
+
+	// frame types of each class
+	const uint8_t urgentType = 1;
+	const uint8_t normalType = 2;
+	const uint8_t bulkType   = 3;
+
+	DownlinkScheduler::Classes classes()
+	{
+		DownlinkScheduler::Classes c;
+
+		c.fill( DownlinkScheduler::normal );
+		c[urgentType] = DownlinkScheduler::urgent;
+		c[bulkType]   = DownlinkScheduler::bulk;
+
+		return c;
+	}
+
+	FramePool::Handle frame( FramePool& pool, const uint8_t address, const uint8_t type,
+		const uint8_t content = 0 )
+	{
+		FramePool::Handle f = pool.acquire();
+
+		f->header[0]  = address;
+		f->header[1]  = type;
+		f->header[2]  = 1;
+		f->payload[0] = content;
+
+		return f;
+	}
+
+	/**
+	 * @return Whether the next frame is the expected one.
+	 */
+	bool next( DownlinkScheduler& scheduler, const Clock::time_point now, const uint8_t address,
+		const uint8_t type, const uint8_t content = 0 )
+	{
+		const FramePool::Handle f = scheduler.pop( now );
+
+		return f && f->address() == address && f->type() == type && f->payload[0] == content;
+	}
+}
+
+
+TEST( downlink_order_by_deadline )
+{
+	FramePool         pool;
+	DownlinkScheduler scheduler( classes(), 16 );
+	const Clock::time_point t = Clock::now();
+
+	CHECK( scheduler.push( frame( pool, 1, bulkType ), t ) );
+	CHECK( scheduler.push( frame( pool, 2, bulkType ), t ) );
+	CHECK( scheduler.push( frame( pool, 3, normalType ), t ) );
+	CHECK( scheduler.push( frame( pool, 4, urgentType ), t ) );
+
+	// a bulk frame that has waited long enough is due before a new urgent one
+	CHECK( scheduler.push( frame( pool, 5, urgentType ), t + std::chrono::seconds( 20 ) ) );
+
+	CHECK( scheduler.size() == 5 );
+
+	const Clock::time_point later = t + std::chrono::seconds( 20 );
+
+	CHECK( next( scheduler, later, 4, urgentType ) );
+	CHECK( next( scheduler, later, 3, normalType ) );
+	CHECK( next( scheduler, later, 1, bulkType ) );
+	CHECK( next( scheduler, later, 2, bulkType ) );
+	CHECK( next( scheduler, later, 5, urgentType ) );
+	CHECK( scheduler.empty() );
+	CHECK( !scheduler.pop( later ) );
+
+	CHECK( scheduler.statistics( DownlinkScheduler::urgent ).sent == 2 );
+	CHECK( scheduler.statistics( DownlinkScheduler::urgent ).late == 1 );
+	CHECK( scheduler.statistics( DownlinkScheduler::normal ).late == 1 );
+	CHECK( scheduler.statistics( DownlinkScheduler::bulk ).late == 2 );
+}
+
+
+TEST( downlink_ties_go_to_higher_class )
+{
+	FramePool         pool;
+	DownlinkScheduler scheduler( classes(), 16 );
+	const Clock::time_point t = Clock::now();
+
+	// both are due at the same time
+	CHECK( scheduler.push( frame( pool, 1, normalType ), t ) );
+	CHECK( scheduler.push( frame( pool, 2, urgentType ), t + std::chrono::milliseconds( 900 ) ) );
+
+	CHECK( next( scheduler, t, 2, urgentType ) );
+	CHECK( next( scheduler, t, 1, normalType ) );
+}
+
+
+TEST( downlink_coalescing )
+{
+	FramePool         pool;
+	DownlinkScheduler scheduler( classes(), 16 );
+	const Clock::time_point t = Clock::now();
+
+	CHECK( scheduler.push( frame( pool, 1, normalType, 10 ), t ) );
+	CHECK( scheduler.push( frame( pool, 2, normalType, 20 ), t ) );
+	CHECK( scheduler.push( frame( pool, 1, normalType, 11 ), t ) );
+	CHECK( scheduler.push( frame( pool, 1, bulkType, 12 ), t ) );
+	CHECK( scheduler.push( frame( pool, 1, normalType, 13 ), t ) );
+
+	CHECK( scheduler.size() == 3 );
+	CHECK( scheduler.statistics( DownlinkScheduler::normal ).coalesced == 2 );
+
+	// the newest content at the place of the first frame
+	CHECK( next( scheduler, t, 1, normalType, 13 ) );
+	CHECK( next( scheduler, t, 2, normalType, 20 ) );
+	CHECK( next( scheduler, t, 1, bulkType, 12 ) );
+}
+
+
+TEST( downlink_full_queue_evicts_lower_class )
+{
+	FramePool         pool;
+	DownlinkScheduler scheduler( classes(), 3 );
+	const Clock::time_point t = Clock::now();
+
+	CHECK( scheduler.push( frame( pool, 1, bulkType ), t ) );
+	CHECK( scheduler.push( frame( pool, 2, bulkType ), t ) );
+	CHECK( scheduler.push( frame( pool, 3, normalType ), t ) );
+	CHECK( scheduler.full() );
+
+	// no lower class to make room
+	CHECK( !scheduler.push( frame( pool, 4, bulkType ), t ) );
+	CHECK( scheduler.statistics( DownlinkScheduler::bulk ).dropped == 1 );
+
+	// the newest bulk frame makes room
+	CHECK( scheduler.push( frame( pool, 5, urgentType ), t ) );
+	CHECK( scheduler.statistics( DownlinkScheduler::bulk ).dropped == 2 );
+	CHECK( scheduler.push( frame( pool, 6, normalType ), t ) );
+	CHECK( scheduler.statistics( DownlinkScheduler::bulk ).dropped == 3 );
+	CHECK( scheduler.size() == 3 );
+
+	CHECK( !scheduler.push( frame( pool, 7, normalType ), t ) );
+	CHECK( scheduler.statistics( DownlinkScheduler::normal ).dropped == 1 );
+
+	// a normal frame makes room for an urgent one
+	CHECK( scheduler.push( frame( pool, 8, urgentType ), t ) );
+	CHECK( scheduler.statistics( DownlinkScheduler::normal ).dropped == 2 );
+
+	// a full queue still coalesces
+	CHECK( scheduler.push( frame( pool, 8, urgentType, 1 ), t ) );
+
+	CHECK( next( scheduler, t, 5, urgentType ) );
+	CHECK( next( scheduler, t, 8, urgentType, 1 ) );
+	CHECK( next( scheduler, t, 3, normalType ) );
+	CHECK( scheduler.empty() );
+}
+
+
+TEST( downlink_clear_counts_dropped )
+{
+	FramePool         pool;
+	DownlinkScheduler scheduler( classes(), 16 );
+	const Clock::time_point t = Clock::now();
+
+	scheduler.push( frame( pool, 1, urgentType ), t );
+	scheduler.push( frame( pool, 2, bulkType ), t );
+	scheduler.push( frame( pool, 3, bulkType ), t );
+	scheduler.clear();
+
+	CHECK( scheduler.empty() );
+	CHECK( scheduler.statistics( DownlinkScheduler::urgent ).dropped == 1 );
+	CHECK( scheduler.statistics( DownlinkScheduler::bulk ).dropped == 2 );
+
+	scheduler.drop( *frame( pool, 4, normalType ) );
+	CHECK( scheduler.statistics( DownlinkScheduler::normal ).dropped == 1 );
+}
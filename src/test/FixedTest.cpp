@@ -0,0 +1,109 @@
+/*
+ * FixedTest.cpp
+ *
+ *  Created on: 2026-10-17
+ *      Author: agent
+ */
+
+#include <cmath>
+#include <limits>
+
+#include "Numeric.h"
+#include "Test.h"
+
+namespace
+{
+	const int32_t max = std::numeric_limits<int32_t>::max();
+	const int32_t min = std::numeric_limits<int32_t>::min();
+}
+
+
+TEST( fixed_conversion )
+{
+	CHECK( q16_16_t( 1 ).raw() == 1 << 16 );
+	CHECK( q16_16_t( -3 ).raw() == -3 * ( 1 << 16 ) );
+	CHECK( q16_16_t( .5f ).raw() == 1 << 15 );
+	CHECK( std::fabs( q16_16_t( -.25f ).to_float() + .25f ) < 1e-9 );
+
+	// rounded to the nearest representable value, ties away from zero
+	CHECK( q16_16_t( 1.5 / 65536 ).raw() == 2 );
+	CHECK( q16_16_t( -1.5 / 65536 ).raw() == -2 );
+	CHECK( q16_16_t( 1.4 / 65536 ).raw() == 1 );
+}
+
+
+TEST( fixed_conversion_saturates )
+{
+	CHECK( q8_24_t( 128 ).raw() == max );
+	CHECK( q8_24_t( -129 ).raw() == min );
+	CHECK( q8_24_t( 1000.f ).raw() == max );
+	CHECK( q8_24_t( -1000.f ).raw() == min );
+	CHECK( q16_16_t( 1e30 ).raw() == max );
+	CHECK( q16_16_t( 40000 ).raw() == max );
+}
+
+
+TEST( fixed_addition_saturates )
+{
+	const q16_16_t highest = std::numeric_limits<q16_16_t>::max();
+	const q16_16_t lowest  = std::numeric_limits<q16_16_t>::lowest();
+
+	CHECK( q16_16_t( 2 ) + q16_16_t( 3 ) == q16_16_t( 5 ) );
+	CHECK( q16_16_t( 2 ) - q16_16_t( 3 ) == q16_16_t( -1 ) );
+	CHECK( highest + q16_16_t::from_raw( 1 ) == highest );
+	CHECK( lowest - q16_16_t::from_raw( 1 ) == lowest );
+	CHECK( highest + highest == highest );
+	CHECK( lowest + lowest == lowest );
+	CHECK( -lowest == highest );
+}
+
+
+TEST( fixed_multiplication )
+{
+	CHECK( q16_16_t( 3 ) * q16_16_t( -4 ) == q16_16_t( -12 ) );
+	CHECK( q16_16_t( .5f ) * q16_16_t( .5f ) == q16_16_t( .25f ) );
+	CHECK( q16_16_t( 7 ) * 3 == q16_16_t( 21 ) );
+
+	// half of the smallest step rounds up
+	CHECK( q16_16_t::from_raw( 1 ) * q16_16_t( .5f ) == q16_16_t::from_raw( 1 ) );
+
+	CHECK( q8_24_t( 100 ) * q8_24_t( 100 ) == std::numeric_limits<q8_24_t>::max() );
+	CHECK( q8_24_t( 100 ) * q8_24_t( -100 ) == std::numeric_limits<q8_24_t>::lowest() );
+	CHECK( q8_24_t( 100 ) * 2 == std::numeric_limits<q8_24_t>::max() );
+}
+
+
+TEST( fixed_division )
+{
+	CHECK( q16_16_t( 1 ) / q16_16_t( 4 ) == q16_16_t( .25f ) );
+	CHECK( q16_16_t( -9 ) / 3 == q16_16_t( -3 ) );
+	CHECK( q8_24_t( 100 ) / q8_24_t( .01f ) == std::numeric_limits<q8_24_t>::max() );
+
+	// a division by zero saturates according to the sign, zero counts as positive
+	CHECK( q16_16_t( 1 ) / q16_16_t( 0 ) == std::numeric_limits<q16_16_t>::max() );
+	CHECK( q16_16_t( -1 ) / q16_16_t( 0 ) == std::numeric_limits<q16_16_t>::lowest() );
+	CHECK( q16_16_t( 0 ) / q16_16_t( 0 ) == std::numeric_limits<q16_16_t>::max() );
+	CHECK( q16_16_t( -1 ) / 0 == std::numeric_limits<q16_16_t>::lowest() );
+}
+
+
+TEST( fixed_policy )
+{
+	typedef NumericPolicy<q16_16_t> P;
+
+	CHECK( P::mac( q16_16_t( 1 ), q16_16_t( 2 ), q16_16_t( 3 ) ) == q16_16_t( 7 ) );
+	CHECK( P::mac( std::numeric_limits<q16_16_t>::max(), q16_16_t( 1 ), q16_16_t( 1 ) )
+		== std::numeric_limits<q16_16_t>::max() );
+	CHECK( P::mac( q16_16_t( 0 ), q16_16_t( -200 ), q16_16_t( 200 ) ) == std::numeric_limits<q16_16_t>::lowest() );
+
+	CHECK( P::reciprocal<4>() == q16_16_t( .25f ) );
+	CHECK( P::reciprocal<3>().raw() == 21845 );
+
+	CHECK( P::ceil( q16_16_t( 2 ) ) == 2 );
+	CHECK( P::ceil( q16_16_t( 2.01f ) ) == 3 );
+	CHECK( P::ceil( q16_16_t( -1.5f ) ) == -1 );
+	CHECK( P::ceil( q16_16_t( 0 ) ) == 0 );
+
+	CHECK( numeric_cast<q8_24_t>( q16_16_t( 1.5f ) ) == q8_24_t( 1.5f ) );
+	CHECK( std::fabs( numeric_cast<float>( q16_16_t( -2 ) ) + 2 ) < 1e-9 );
+}
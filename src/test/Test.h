@@ -0,0 +1,52 @@
+/*
+ * Test.h
+ *
+ *  Created on: 2026-10-17
+ *      Author: agent
+ */
+
+#ifndef TEST_H_J6QW2RNB
+#define TEST_H_J6QW2RNB
+
+#include <vector>
+
+/**
+ * A minimal test harness for the host-buildable code.
+ *
+ * A test is a function declared with `TEST()`, which registers itself
+ * before `main()` runs. `CHECK()` records a failed condition and carries on,
+ * so one run reports every failure. The program exits with a failure if
+ * any check failed.
+ */
+namespace Test
+{
+	typedef void ( *Function )();
+
+	struct Case
+	{
+		const char *name;
+		Function    function;
+	};
+
+	std::vector<Case>& cases();
+
+	struct Registration
+	{
+		Registration( const char *name, const Function function )
+		{
+			const Case c = { name, function };
+			cases().push_back( c );
+		}
+	};
+
+	void check( const bool condition, const char *expression, const char *file, const int line );
+}
+
+#define TEST( name ) \
+	static void name(); \
+	static const Test::Registration name##_registration( #name, name ); \
+	static void name()
+
+#define CHECK( condition ) Test::check( ( condition ), #condition, __FILE__, __LINE__ )
+
+#endif /* end of include guard: TEST_H_J6QW2RNB */
@@ -0,0 +1,61 @@
+/*
+ * TransmitSchedulerTest.cpp
+ *
+ *  Created on: 2026-10-17
+ *      Author: agent
+ */
+
+#include <limits>
+
+#include "TransmitScheduler.h"
+#include "Test.h"
+
+namespace
+{
+	const UplinkBatch::Reading zero = { 0, 0, 0, 300, 0 };
+
+	/**
+	 * A batch with `n` readings, due at three.
+	 */
+	UplinkBatch batch( const int n )
+	{
+		UplinkBatch b( 3, 3600 );
+
+		for ( int i = 0; i < n; ++i )
+			b.push( zero );
+
+		return b;
+	}
+
+	const float middle = 1.75f;  ///< between empty and full storage
+}
+
+
+TEST( schedule_storage )
+{
+	CHECK( !TransmitScheduler::transmit( batch( 0 ), 2.5f, 1.f, 0.f ) );
+	CHECK( !TransmitScheduler::transmit( batch( UplinkBatch::capacity ), 1.05f, 1.f, 0.f ) );
+	CHECK( TransmitScheduler::transmit( batch( 1 ), 2.45f, 0.f, 1.f ) );
+}
+
+
+TEST( schedule_forecast )
+{
+	CHECK( TransmitScheduler::transmit( batch( 3 ), middle, 1.f, 1.f ) );
+	CHECK( !TransmitScheduler::transmit( batch( 2 ), middle, 1.f, 1.f ) );
+	CHECK( !TransmitScheduler::transmit( batch( 3 ), middle, .5f, 1.f ) );
+	CHECK( TransmitScheduler::transmit( batch( UplinkBatch::capacity ), middle, .5f, 1.f ) );
+}
+
+
+TEST( schedule_invalid_forecast )
+{
+	const float nan      = std::numeric_limits<float>::quiet_NaN();
+	const float infinity = std::numeric_limits<float>::infinity();
+
+	CHECK( !TransmitScheduler::transmit( batch( 3 ), middle, nan, 1.f ) );
+	CHECK( !TransmitScheduler::transmit( batch( 3 ), middle, 1.f, nan ) );
+	CHECK( !TransmitScheduler::transmit( batch( 3 ), middle, infinity, 1.f ) );
+	CHECK( !TransmitScheduler::transmit( batch( 3 ), middle, std::numeric_limits<float>::max(), 1.f ) );
+	CHECK( TransmitScheduler::transmit( batch( UplinkBatch::capacity ), middle, nan, 1.f ) );
+}
@@ -0,0 +1,217 @@
+/*
+ * UplinkBatchTest.cpp
+ *
+ *  Created on: 2026-10-17
+ *      Author: agent
+ */
+
+#include "UplinkBatch.h"
+#include "Test.h"
+
+namespace
+{
+	UplinkBatch::Reading reading( const int16_t temperature, const uint16_t humidity,
+		const uint16_t slices, const uint16_t sleep, const uint16_t battery )
+	{
+		const UplinkBatch::Reading r = { temperature, humidity, slices, sleep, battery };
+		return r;
+	}
+
+	bool equal( const UplinkBatch::Reading& a, const UplinkBatch::Reading& b )
+	{
+		return a.temperature == b.temperature && a.humidity == b.humidity
+			&& a.adaptive_slices == b.adaptive_slices && a.sleep_time == b.sleep_time
+			&& a.battery_level == b.battery_level;
+	}
+
+	/**
+	 * Encodes the whole batch and decodes it again.
+	 *
+	 * @return Whether every reading came back unchanged.
+	 */
+	bool roundTrip( const UplinkBatch& batch, const UplinkBatch::Reading *expected )
+	{
+		uint8_t buffer[255];
+		uint8_t bytes;
+
+		const uint8_t n = batch.encode( buffer, sizeof( buffer ), bytes );
+
+		UplinkBatch::Reading decoded[UplinkBatch::capacity];
+
+		if ( n != batch.count() || UplinkBatch::decode( buffer, bytes, n, decoded ) != n )
+			return false;
+
+		for ( uint8_t i = 0; i < n; ++i )
+			if ( !equal( decoded[i], expected[i] ) )
+				return false;
+
+		return true;
+	}
+}
+
+
+TEST( batch_round_trip )
+{
+	UplinkBatch          batch( 10, 3600 );
+	UplinkBatch::Reading readings[4] = {
+		reading( 215, 455, 12, 300, 3300 ),
+		reading( 216, 450, 12, 300, 3290 ),
+		reading( -43, 1000, 48, 1800, 2100 ),
+		reading( 0, 0, 0, 0, 0 )
+	};
+
+	for ( uint8_t i = 0; i < 4; ++i )
+		batch.push( readings[i] );
+
+	CHECK( roundTrip( batch, readings ) );
+}
+
+
+TEST( batch_extremes_round_trip )
+{
+	// the largest differences, which take three bytes in zigzag encoding
+	UplinkBatch          batch( 10, 3600 );
+	UplinkBatch::Reading readings[4] = {
+		reading( 32767, 65535, 65535, 65535, 65535 ),
+		reading( -32768, 0, 0, 0, 0 ),
+		reading( 32767, 65535, 65535, 65535, 65535 ),
+		reading( -1, 1, 1, 1, 1 )
+	};
+
+	for ( uint8_t i = 0; i < 4; ++i )
+		batch.push( readings[i] );
+
+	CHECK( roundTrip( batch, readings ) );
+
+	uint8_t buffer[255];
+	uint8_t bytes;
+
+	batch.encode( buffer, sizeof( buffer ), bytes );
+	CHECK( bytes <= 4 * UplinkBatch::maxEncodedSize );
+}
+
+
+TEST( batch_small_differences_take_one_byte )
+{
+	UplinkBatch batch( 10, 3600 );
+
+	batch.push( reading( 0, 0, 0, 0, 0 ) );
+	batch.push( reading( 63, 63, 63, 63, 63 ) );
+	batch.push( reading( -1, 0, 0, 0, 0 ) );
+
+	uint8_t buffer[3 * UplinkBatch::maxEncodedSize];
+	uint8_t bytes;
+
+	CHECK( batch.encode( buffer, sizeof( buffer ), bytes ) == 3 );
+	CHECK( bytes == 3 * UplinkBatch::fields );
+}
+
+
+TEST( batch_encode_stops_at_size )
+{
+	UplinkBatch batch( 10, 3600 );
+
+	for ( int i = 0; i < 5; ++i )
+		batch.push( reading( 0, 0, 0, 0, 0 ) );
+
+	uint8_t buffer[2 * UplinkBatch::fields + 1];
+	uint8_t bytes;
+
+	CHECK( batch.encode( buffer, sizeof( buffer ), bytes ) == 2 );
+	CHECK( bytes == 2 * UplinkBatch::fields );
+}
+
+
+TEST( batch_decode_truncated )
+{
+	UplinkBatch batch( 10, 3600 );
+
+	batch.push( reading( 1000, 1000, 1000, 1000, 1000 ) );
+	batch.push( reading( 0, 0, 0, 0, 0 ) );
+
+	uint8_t buffer[2 * UplinkBatch::maxEncodedSize];
+	uint8_t bytes;
+
+	batch.encode( buffer, sizeof( buffer ), bytes );
+
+	UplinkBatch::Reading decoded[2];
+
+	// the last number is cut in half, so only the first reading is complete
+	CHECK( UplinkBatch::decode( buffer, static_cast<uint8_t>( bytes - 1 ), 2, decoded ) == 1 );
+	CHECK( equal( decoded[0], reading( 1000, 1000, 1000, 1000, 1000 ) ) );
+
+	// a continuation bit on the last byte never ends the number
+	uint8_t garbage[] = { 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 };
+	CHECK( UplinkBatch::decode( garbage, sizeof( garbage ), 1, decoded ) == 0 );
+}
+
+
+TEST( batch_quantize_clamps )
+{
+	const UplinkBatch::Reading r = UplinkBatch::quantize( -5000.f, -1.f, 70000, 12, 3.3004f );
+
+	CHECK( r.temperature == -32768 );
+	CHECK( r.humidity == 0 );
+	CHECK( r.adaptive_slices == 65535 );
+	CHECK( r.sleep_time == 12 );
+	CHECK( r.battery_level == 3300 );
+
+	CHECK( UplinkBatch::quantize( 21.46f, 45.04f, 0, 0, 0 ).temperature == 215 );
+	CHECK( UplinkBatch::quantize( -21.46f, 45.04f, 0, 0, 0 ).temperature == -215 );
+}
+
+
+TEST( batch_full_drops_oldest )
+{
+	UplinkBatch batch( UplinkBatch::capacity, 1000000 );
+
+	for ( int i = 0; i <= UplinkBatch::capacity; ++i )
+		batch.push( reading( static_cast<int16_t>( i ), 0, 0, 10, 0 ) );
+
+	CHECK( batch.full() );
+	CHECK( batch.oldest().temperature == 1 );
+	CHECK( batch.age() == 10 * ( UplinkBatch::capacity - 1 ) );
+
+	batch.drop( 200 );
+	CHECK( batch.count() == 0 );
+	CHECK( batch.age() == 0 );
+	CHECK( !batch.due() );
+}
+
+
+TEST( batch_due )
+{
+	UplinkBatch batch( 3, 600 );
+
+	batch.push( reading( 0, 0, 0, 300, 0 ) );
+	batch.push( reading( 0, 0, 0, 300, 0 ) );
+	CHECK( !batch.due() );
+
+	batch.push( reading( 0, 0, 0, 300, 0 ) );
+	CHECK( batch.due() );
+
+	batch.drop( 2 );
+	CHECK( !batch.due() );
+
+	// the oldest reading is as old as the sleep times after it
+	batch.push( reading( 0, 0, 0, 600, 0 ) );
+	CHECK( batch.age() == 300 );
+	batch.push( reading( 0, 0, 0, 0, 0 ) );
+	CHECK( batch.age() == 900 );
+	CHECK( batch.due() );
+}
+
+
+TEST( batch_reading_age )
+{
+	const UplinkBatch::Reading readings[3] = {
+		reading( 0, 0, 0, 300, 0 ),
+		reading( 0, 0, 0, 600, 0 ),
+		reading( 0, 0, 0, 900, 0 )
+	};
+
+	CHECK( UplinkBatch::age( readings, 3, 0 ) == 900 );
+	CHECK( UplinkBatch::age( readings, 3, 1 ) == 600 );
+	CHECK( UplinkBatch::age( readings, 3, 2 ) == 0 );
+	CHECK( UplinkBatch::age( readings, 1, 0 ) == 0 );
+}
@@ -0,0 +1,120 @@
+/*
+ * WCMATest.cpp
+ *
+ *  Created on: 2026-10-17
+ *      Author: agent
+ */
+
+#include <cmath>
+#include <limits>
+
+#include "WCMA.h"
+#include "BatchWCMA.h"
+#include "Test.h"
+
+namespace
+{
+	/**
+	 * A platform in constant light, see `Platform.h`.
+	 */
+	struct ConstantPlatform
+	{
+		float getLuminance()
+		{
+			return 1;
+		}
+
+		float getStorageVoltage()
+		{
+			return 2;
+		}
+
+		void resetClock()
+		{
+		}
+
+		void sleep( const unsigned int )
+		{
+		}
+	};
+
+	typedef WCMA<48, 4, 3, float, ConstantPlatform>    wcma_t;
+	typedef WCMA<48, 4, 3, q16_16_t, ConstantPlatform> wcma_fixed_t;
+	typedef WCMA<48, 4, 1, float, ConstantPlatform>    wcma_single_t;
+
+	bool near( const float a, const float b )
+	{
+		return std::fabs( a - b ) < 1e-4f;
+	}
+}
+
+
+TEST( wcma_weights_normalised )
+{
+	wcma_t wcma;
+
+	// the default, linear weights
+	CHECK( near( wcma.weights()[0], 1.f / 6 ) );
+	CHECK( near( wcma.weights()[2], 3.f / 6 ) );
+
+	const float weights[3] = { 2, 2, 4 };
+
+	CHECK( wcma.setWeights( weights ) );
+	CHECK( near( wcma.weights()[0], .25f ) );
+	CHECK( near( wcma.weights()[2], .5f ) );
+
+	CHECK( wcma.setExponentialWeights( .5f ) );
+	CHECK( near( wcma.weights()[0], 1.f / 7 ) );
+	CHECK( near( wcma.weights()[2], 4.f / 7 ) );
+}
+
+
+TEST( wcma_invalid_weights_rejected )
+{
+	const float nan      = std::numeric_limits<float>::quiet_NaN();
+	const float infinity = std::numeric_limits<float>::infinity();
+
+	const float zero[3]     = { 0, 0, 0 };
+	const float negative[3] = { 1, -1, 1 };
+	const float invalid[3]  = { 1, nan, 1 };
+	const float huge[3]     = { 1, infinity, 1 };
+
+	wcma_t       wcma;
+	wcma_fixed_t fixed;
+
+	CHECK( !wcma.setWeights( zero ) );
+	CHECK( !wcma.setWeights( negative ) );
+	CHECK( !wcma.setWeights( invalid ) );
+	CHECK( !wcma.setWeights( huge ) );
+	CHECK( !wcma.setExponentialWeights( -1 ) );
+	CHECK( !wcma.setExponentialWeights( nan ) );
+	CHECK( !fixed.setWeights( zero ) );
+
+	// the previous weights are kept
+	CHECK( near( wcma.weights()[0], 1.f / 6 ) );
+	CHECK( near( wcma.weights()[2], 3.f / 6 ) );
+	CHECK( near( to_float( fixed.weights()[2] ), 3.f / 6 ) );
+
+	// a single sample keeps its weight of one, whatever the base
+	wcma_single_t single;
+
+	CHECK( single.setExponentialWeights( 0 ) );
+	CHECK( near( single.weights()[0], 1 ) );
+
+	const float none[1] = { 0 };
+	CHECK( !single.setWeights( none ) );
+	CHECK( near( single.weights()[0], 1 ) );
+}
+
+
+TEST( batch_wcma_invalid_weights_rejected )
+{
+	BatchWCMA<48, 4, 3, float> batch( 2 );
+
+	const float zero[3]  = { 0, 0, 0 };
+	const float valid[3] = { 1, 1, 1 };
+
+	CHECK( !batch.setWeights( zero ) );
+	CHECK( !batch.setExponentialWeights( -1 ) );
+	CHECK( batch.setWeights( valid ) );
+}
@@ -0,0 +1,158 @@
+/*
+ * WireFormatTest.cpp
+ *
+ *  Created on: 2026-10-17
+ *      Author: agent
+ */
+
+#include "WireFormat.h"
+#include "Test.h"
+
+namespace
+{
+	UplinkBatch::Reading reading( const int16_t temperature, const uint16_t humidity,
+		const uint16_t slices, const uint16_t sleep, const uint16_t battery )
+	{
+		const UplinkBatch::Reading r = { temperature, humidity, slices, sleep, battery };
+		return r;
+	}
+}
+
+
+TEST( wire_header )
+{
+	uint8_t frame[WireFormat::maxFrameSize];
+
+	WireFormat::encodeReading( 0xab, WireFormat::allFields, reading( 0, 0, 0, 0, 0 ), frame );
+
+	WireFormat::Header header;
+
+	CHECK( WireFormat::decodeHeader( frame, WireFormat::headerSize, header ) );
+	CHECK( header.version == WireFormat::version );
+	CHECK( header.type == WireFormat::reading );
+	CHECK( header.fields == WireFormat::allFields );
+	CHECK( header.node_id == 0xab );
+
+	CHECK( !WireFormat::decodeHeader( frame, 1, header ) );
+
+	// another version
+	frame[0] ^= 0xc0;
+	CHECK( !WireFormat::decodeHeader( frame, WireFormat::headerSize, header ) );
+}
+
+
+TEST( wire_reading_round_trip )
+{
+	const UplinkBatch::Reading r = reading( -215, 455, 48, 1800, 3300 );
+
+	uint8_t frame[WireFormat::maxFrameSize];
+
+	const uint8_t size = WireFormat::encodeReading( 5, WireFormat::allFields, r, frame );
+	CHECK( size == WireFormat::headerSize + 10 );
+
+	// little-endian
+	CHECK( frame[2] == static_cast<uint8_t>( -215 & 0xff ) );
+	CHECK( frame[3] == static_cast<uint8_t>( -215 >> 8 & 0xff ) );
+
+	UplinkBatch::Reading d;
+
+	CHECK( WireFormat::decodeReading( frame, size, d ) );
+	CHECK( d.temperature == -215 );
+	CHECK( d.humidity == 455 );
+	CHECK( d.adaptive_slices == 48 );
+	CHECK( d.sleep_time == 1800 );
+	CHECK( d.battery_level == 3300 );
+
+	CHECK( !WireFormat::decodeReading( frame, size - 1, d ) );
+}
+
+
+TEST( wire_reading_partial_fields )
+{
+	uint8_t frame[WireFormat::maxFrameSize];
+
+	const uint8_t size = WireFormat::encodeReading( 5, WireFormat::slices | WireFormat::battery,
+		reading( 215, 455, 48, 1800, 3300 ), frame );
+	CHECK( size == WireFormat::headerSize + 4 );
+
+	UplinkBatch::Reading d;
+
+	CHECK( WireFormat::decodeReading( frame, size, d ) );
+	CHECK( d.temperature == 0 );
+	CHECK( d.humidity == 0 );
+	CHECK( d.adaptive_slices == 48 );
+	CHECK( d.sleep_time == 0 );
+	CHECK( d.battery_level == 3300 );
+}
+
+
+TEST( wire_batch_fills_frame )
+{
+	UplinkBatch batch( UplinkBatch::capacity, 1000000 );
+
+	for ( int i = 0; i < UplinkBatch::capacity; ++i )
+		batch.push( reading( static_cast<int16_t>( 200 + i ), 450, 12, 300, static_cast<uint16_t>( 3300 - i ) ) );
+
+	uint8_t frame[WireFormat::maxFrameSize];
+	uint8_t count;
+
+	const uint8_t size = WireFormat::encodeBatch( 7, batch, frame, count );
+	CHECK( size <= WireFormat::maxFrameSize );
+	CHECK( count > 1 );
+	CHECK( count < UplinkBatch::capacity );
+
+	UplinkBatch::Reading d[UplinkBatch::capacity];
+
+	CHECK( WireFormat::decodeBatch( frame, size, d ) == count );
+
+	for ( uint8_t i = 0; i < count; ++i )
+	{
+		CHECK( d[i].temperature == 200 + i );
+		CHECK( d[i].battery_level == 3300 - i );
+	}
+
+	// a count beyond the capacity is cut
+	frame[WireFormat::headerSize] = 0xff;
+	CHECK( WireFormat::decodeBatch( frame, size, d ) == count );
+
+	CHECK( WireFormat::decodeBatch( frame, WireFormat::headerSize, d ) == 0 );
+}
+
+
+TEST( wire_energy_log )
+{
+	uint8_t frame[WireFormat::maxFrameSize] = { 0x60, 9, 2 };
+	uint8_t size                            = WireFormat::headerSize + 1;
+
+	for ( uint8_t r = 0; r < 2; ++r )
+	{
+		for ( uint8_t p = 0; p < EnergyLog::phases; ++p )
+		{
+			frame[size++] = 0x78;
+			frame[size++] = 0x56;
+			frame[size++] = 0x34;
+			frame[size++] = static_cast<uint8_t>( 0x12 + p );
+		}
+
+		for ( uint8_t p = 0; p < EnergyLog::phases; ++p )
+		{
+			frame[size++] = p;
+			frame[size++] = 0x80;
+		}
+
+		frame[size++] = r;
+		frame[size++] = 1;
+	}
+
+	EnergyLog::Record records[WireFormat::maxFrameSize / WireFormat::recordSize];
+
+	CHECK( WireFormat::decodeEnergyLog( frame, size, records ) == 2 );
+	CHECK( records[0].time[0] == 0x12345678 );
+	CHECK( records[1].time[EnergyLog::phases - 1] == 0x12345678u + ( ( EnergyLog::phases - 1u ) << 24 ) );
+	CHECK( records[1].energy[1] == 0x8001 );
+	CHECK( records[0].sequence == 0x100 );
+	CHECK( records[1].sequence == 0x101 );
+
+	// a record cut short is not read
+	CHECK( WireFormat::decodeEnergyLog( frame, size - 1, records ) == 1 );
+}
@@ -0,0 +1,52 @@
+/*
+ * tests.cpp
+ *
+ * Runs all registered tests, see `Test.h`.
+ *
+ *  Created on: 2026-10-17
+ *      Author: agent
+ */
+
+#include <cstdlib>
+#include <iostream>
+
+#include "Test.h"
+
+namespace
+{
+	unsigned long failures = 0;
+}
+
+
+std::vector<Test::Case>& Test::cases()
+{
+	static std::vector<Case> registered;
+	return registered;
+}
+
+
+void Test::check( const bool condition, const char *expression, const char *file, const int line )
+{
+	if ( condition )
+		return;
+
+	++failures;
+	std::cerr << file << ":" << line << ": check failed: " << expression << std::endl;
+}
+
+
+int main()
+{
+	for ( const Test::Case& c : Test::cases() )
+	{
+		const unsigned long before = failures;
+
+		c.function();
+
+		std::cout << ( failures == before ? "ok     " : "FAILED " ) << c.name << std::endl;
+	}
+
+	std::cout << Test::cases().size() << " tests, " << failures << " failed checks" << std::endl;
+
+	return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}